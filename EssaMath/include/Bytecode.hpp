@@ -0,0 +1,373 @@
+#pragma once
+
+#include "include/Lexer.hpp"
+#include "include/OperatorHelpers.hpp"
+#include "include/VectorKernels.hpp"
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Essa::Math{
+   template <typename T>
+   class ifunction;
+
+   namespace details
+   {
+      template <typename T>
+      class bytecode_builder;
+
+      template <typename T>
+      class jit_program;
+
+      template <typename T>
+      class cpp_generator;
+
+      template <typename T>
+      class derivative_program;
+
+      // Binds a variable used by a program to a column of per-row values
+      // for bytecode_program::value_batch().
+      template <typename T>
+      struct bytecode_column
+      {
+         bytecode_column(T& var, const T* values)
+         : variable(&var)
+         , data(values)
+         {}
+
+         T*       variable;
+         const T* data;
+      };
+
+      // A compiled expression lowered into a linear instruction array.
+      // Operands are addresses: either a slot in the program's register
+      // file (temporaries and constants) or memory owned by a variable or
+      // a node of the tree the program was built from, which therefore has
+      // to outlive it. Evaluation writes the register file, so a program
+      // must not be evaluated from several threads at once.
+      template <typename T>
+      class bytecode_program
+      {
+      public:
+
+         typedef typename functor_t<T>::bfunc_t bfunc_t;
+         typedef typename functor_t<T>::ufunc_t ufunc_t;
+         typedef typename functor_t<T>::tfunc_t tfunc_t;
+         typedef typename functor_t<T>::qfunc_t qfunc_t;
+         typedef vec_data_store<T>              vds_t;
+         typedef typename vector_kernels<T>::unary_t kernel_t;
+         typedef T (*invoke_t)(ifunction<T>&, const T* const*);
+
+         enum opcode
+         {
+            e_halt       , e_mov        , e_add        , e_sub        ,
+            e_mul        , e_div        , e_neg        , e_ufunc      ,
+            e_bfunc      , e_tfunc      , e_qfunc      , e_jump       ,
+            e_jump_false , e_call       , e_vecvec     , e_vecval     ,
+            e_valvec     , e_vecunary   , e_select     , e_function
+         };
+
+         struct vector_operation
+         {
+            bfunc_t      bf;
+            ufunc_t      uf;
+            // Runs a unary operation in place of calling uf per element.
+            kernel_t     kernel;
+            const vds_t* v0;
+            const vds_t* v1;
+            const vds_t* result;
+         };
+
+         struct quaternary_operation
+         {
+            qfunc_t  qf;
+            const T* d;
+         };
+
+         // A call of a user supplied function, invoke passes it the
+         // values of the arguments.
+         struct function_operation
+         {
+            ifunction<T>*         function;
+            invoke_t              invoke;
+            std::vector<const T*> argument_list;
+         };
+
+         struct instruction
+         {
+            opcode   op;
+            T*       r;
+            const T* a;
+            const T* b;
+            const T* c;
+
+            union
+            {
+               bfunc_t                     bf;
+               ufunc_t                     uf;
+               tfunc_t                     tf;
+               const quaternary_operation* qop;
+               const vector_operation*     vop;
+               const function_operation*   fop;
+               const expression_node<T>*   node;
+               std::size_t                 target;
+            };
+         };
+
+         bytecode_program();
+
+         T value() const;
+
+         // Runs a single instruction that neither jumps nor halts.
+         static void execute(const instruction& inst);
+
+         // Evaluates the program once per row, running each instruction
+         // over a block of rows at a time. Variables bound to a column read
+         // that column, all other memory is read as a per-batch constant.
+         // Returns false, without writing any result, for programs whose
+         // rows cannot be evaluated independently: ones containing jumps,
+         // calls back into the tree or into user functions, vector
+         // operations, writes to a bound variable or reads of memory the
+         // program itself writes earlier. With vector_math the functions
+         // vector_math has kernels for are run through them.
+         bool value_batch(const bytecode_column<T>* column_list, const std::size_t column_count,
+                          T* result, const std::size_t rows, const std::size_t block_size,
+                          const bool vector_math = false) const;
+
+         std::size_t size() const;
+
+         std::size_t register_count() const;
+
+         // Number of instructions that hand a subtree back to the tree
+         // walker because the lowering does not cover its node type.
+         std::size_t call_count() const;
+
+         // Describes the computation for common subexpression elimination:
+         // programs with equal keys compute the same result from the same
+         // memory. Lists the memory outside of the register file that the
+         // program reads and writes, and sets cost to its instruction count
+         // with calls of unary, binary and user functions counted twice.
+         // Returns false for programs that call back into the tree, run
+         // vector operations or call user functions with side effects.
+         bool key(std::string& key, std::vector<const T*>& read_list,
+                  std::vector<const T*>& write_list, std::size_t& cost) const;
+
+      private:
+
+         struct batch_operand
+         {
+            const T*    address;
+            const T*    column;
+            T*          base;
+            bool        read;
+            bool        written;
+         };
+
+         typedef std::map<const T*, std::size_t> batch_operand_map_t;
+         typedef std::vector<batch_operand>      batch_operand_list_t;
+
+         bytecode_program(const bytecode_program<T>&) exprtk_delete;
+         bytecode_program<T>& operator=(const bytecode_program<T>&) exprtk_delete;
+
+         static std::size_t batch_operand_index(const T* address,
+                                                batch_operand_map_t& operand_map,
+                                                batch_operand_list_t& operand_list);
+
+         void key_operand(std::string& key, const T* address, const std::vector<bool>& written,
+                          std::vector<const T*>& address_list) const;
+
+         template <typename Type>
+         static void key_bytes(std::string& key, const Type& value);
+
+         std::vector<instruction>         instruction_list_;
+         mutable std::vector<T>           register_list_;
+         std::deque<vector_operation>     vector_operation_list_;
+         std::deque<quaternary_operation> quaternary_operation_list_;
+         std::deque<function_operation>   function_operation_list_;
+         const T*                         result_;
+         std::size_t                      call_count_;
+
+         friend class bytecode_builder<T>;
+         friend class jit_program<T>;
+         friend class cpp_generator<T>;
+         friend class derivative_program<T>;
+      };
+
+      // Used by expression_node::lower() implementations to emit code.
+      // Every emitting method returns the operand holding its result.
+      template <typename T>
+      class bytecode_builder
+      {
+      public:
+
+         typedef std::size_t                                operand_t;
+         typedef bytecode_program<T>                        program_t;
+         typedef typename program_t::bfunc_t                bfunc_t;
+         typedef typename program_t::ufunc_t                ufunc_t;
+         typedef typename program_t::tfunc_t                tfunc_t;
+         typedef typename program_t::qfunc_t                qfunc_t;
+         typedef typename program_t::invoke_t               invoke_t;
+         typedef typename program_t::vds_t                  vds_t;
+         typedef typename program_t::kernel_t               kernel_t;
+         typedef typename program_t::opcode                 opcode_t;
+         typedef typename program_t::instruction            instruction_t;
+
+         static const operand_t no_operand = static_cast<operand_t>(-1);
+
+         // A branch free builder lowers conditionals without jumps, by
+         // evaluating both branches and selecting one of the results, which
+         // makes the program suitable for bytecode_program::value_batch().
+         // A builder sharing values emits an operation at most once between
+         // two jump targets, reusing the earlier result for as long as none
+         // of its operands is written, and lowers shared subexpressions of
+         // the tree where they occur instead of evaluating them lazily.
+         explicit bytecode_builder(program_t& program, const bool branch_free = false, const bool share_values = false);
+
+         // Lowers the tree into the program, fails without touching the
+         // program when the root node itself cannot be lowered.
+         bool build(const expression_node<T>* root);
+
+         // Lowers the trees one after the other into a single program that
+         // stores the value of root[i] in result[i], memory none of the
+         // trees may read. The value of the program is that of the last
+         // tree. Fails without touching the program when a root is null.
+         bool build(const expression_node<T>* const* root, T* result, const std::size_t count);
+
+         // Lowers a node, falling back to a call into the tree walker for
+         // node types that provide no lowering.
+         operand_t lower(const expression_node<T>* node);
+
+         // Lowers branches in evaluation order. An operand that is read
+         // straight from memory is copied into a register first when a
+         // branch evaluated after it has side effects, so it sees the same
+         // value the tree would have. Null branches keep the operand preset
+         // in result.
+         void lower(const expression_node<T>* const* branch, operand_t* result, const std::size_t count);
+
+         operand_t constant (const T& value);
+
+         operand_t reference(const T& value);
+
+         operand_t temporary();
+
+         operand_t copy(const operand_t source);
+
+         operand_t move(const operand_t destination, const operand_t source);
+
+         operand_t unary     (ufunc_t f, const operand_t a, const operand_t result = no_operand);
+
+         operand_t binary    (bfunc_t f, const operand_t a, const operand_t b, const operand_t result = no_operand);
+
+         operand_t trinary   (tfunc_t f, const operand_t a, const operand_t b, const operand_t c);
+
+         operand_t quaternary(qfunc_t f, const operand_t a, const operand_t b, const operand_t c, const operand_t d);
+
+         operand_t vector_vecvec(bfunc_t f, const vds_t& v0, const vds_t& v1, const vds_t& result);
+
+         operand_t vector_vecval(bfunc_t f, const vds_t& v0, const operand_t b, const vds_t& result);
+
+         operand_t vector_valvec(bfunc_t f, const operand_t a, const vds_t& v1, const vds_t& result);
+
+         operand_t vector_unary (ufunc_t f, const vds_t& v0, const vds_t& result, kernel_t kernel = 0);
+
+         operand_t select(const operand_t condition, const operand_t consequent, const operand_t alternative);
+
+         operand_t function(ifunction<T>* f, invoke_t invoke, const operand_t* argument, const std::size_t count);
+
+         bool branch_free() const;
+
+         bool shares_values() const;
+
+         // Count of emitted instructions that write memory outside of the
+         // register file or call back into the tree.
+         std::size_t side_effects() const;
+
+         // The position can become a jump target, so values computed
+         // before it are not shared after it.
+         std::size_t position();
+
+         std::size_t jump(const std::size_t target = 0);
+
+         std::size_t jump_false(const operand_t condition, const std::size_t target = 0);
+
+         void patch(const std::size_t jump_position, const std::size_t target);
+
+      private:
+
+         struct slot
+         {
+            T*   external;
+            T    value;
+            bool shared;
+         };
+
+         // An operation with its function and the identity of its operands,
+         // memory by address and registers by slot.
+         typedef std::vector<std::uintptr_t>      value_key_t;
+         typedef std::map<value_key_t, operand_t> value_map_t;
+         typedef std::map<std::string, operand_t> constant_map_t;
+
+         struct pending_instruction
+         {
+            instruction_t inst;
+            operand_t     r;
+            operand_t     a;
+            operand_t     b;
+            operand_t     c;
+            operand_t     d;
+
+            std::vector<operand_t> argument_list;
+         };
+
+         struct mark_t
+         {
+            std::size_t instructions;
+            std::size_t side_effects;
+         };
+
+         bytecode_builder(const bytecode_builder<T>&) exprtk_delete;
+         bytecode_builder<T>& operator=(const bytecode_builder<T>&) exprtk_delete;
+
+         mark_t mark() const;
+
+         void rollback(const mark_t& m);
+
+         bool is_reference(const operand_t operand) const;
+
+         operand_t new_slot(T* external, const T& value);
+
+         // Empty unless values are shared.
+         value_key_t value_key(const opcode_t op, const std::uintptr_t function,
+                               const operand_t* operand, const std::size_t count);
+
+         bool find_value(const value_key_t& key, operand_t& result) const;
+
+         void remember_value(const value_key_t& key, const operand_t result);
+
+         // Drops the values read from or held in the operand, which is about
+         // to be written.
+         void forget_value(const operand_t operand);
+
+         void forget_values();
+
+         std::size_t emit(const opcode_t op,
+                          const operand_t r = no_operand,
+                          const operand_t a = no_operand,
+                          const operand_t b = no_operand,
+                          const operand_t c = no_operand);
+
+         void finalise(const operand_t result);
+
+         program_t&                       program_;
+         std::vector<slot>                slot_list_;
+         std::vector<pending_instruction> pending_list_;
+         std::size_t                      side_effects_;
+         bool                             branch_free_;
+         bool                             share_values_;
+         value_map_t                      value_map_;
+         constant_map_t                   constant_map_;
+      };
+   }
+}
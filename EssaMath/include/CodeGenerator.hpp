@@ -0,0 +1,127 @@
+#pragma once
+
+#include "include/Bytecode.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Essa::Math{
+   namespace details
+   {
+      // Writes a bytecode program out as a C++ translation unit defining
+      //
+      //    struct name_symbols { T variable; ... T* vector; ... };
+      //    extern "C" T name(name_symbols* symbols);
+      //
+      // which performs the same computation. Registered variables and
+      // vectors become members of the struct, registered user functions
+      // become calls of extern "C" functions of the same name taking and
+      // returning T by value, and any other memory the program only reads
+      // becomes a literal of its value at generation time. Operators and
+      // built in functions are called through the library headers, so the
+      // unit is compiled against them, and it gives the same results as the
+      // program as long as the compiler does not contract floating point
+      // expressions (-ffp-contract=off).
+      template <typename T>
+      class cpp_generator
+      {
+      public:
+
+         typedef bytecode_program<T>             program_t;
+         typedef typename program_t::instruction instruction_t;
+         typedef typename program_t::ufunc_t     ufunc_t;
+         typedef typename program_t::bfunc_t     bfunc_t;
+         typedef typename program_t::tfunc_t     tfunc_t;
+         typedef typename program_t::qfunc_t     qfunc_t;
+
+         cpp_generator();
+
+         // The first registration of a name or an address wins. Names have
+         // to be valid C++ identifiers.
+         void add_variable(const std::string& name, const T& variable);
+
+         void add_vector(const std::string& name, const T* data, const std::size_t size);
+
+         void add_function(const std::string& name, const ifunction<T>* function);
+
+         // Returns false, leaving source untouched and describing the reason
+         // in error(), for programs that call back into the tree or run
+         // vector operations, and for functions it has no name for.
+         bool generate(const program_t& program, const std::string& name, std::string& source);
+
+         const std::string& error() const;
+
+      private:
+
+         struct symbol
+         {
+            std::string name;
+            const T*    data;
+            std::size_t size;
+         };
+
+         typedef std::map<const T*, std::string>             local_map_t;
+         typedef std::pair<std::string, const ifunction<T>*> function_t;
+
+         cpp_generator(const cpp_generator<T>&) exprtk_delete;
+         cpp_generator<T>& operator=(const cpp_generator<T>&) exprtk_delete;
+
+         void add_symbol(const std::string& name, const T* data, const std::size_t size);
+
+         std::string operand(const T* address) const;
+
+         // The member naming address, empty when it belongs to no symbol.
+         std::string symbol_operand(const T* address) const;
+
+         std::string call(const std::string& function, const T* const* argument, const std::size_t count) const;
+
+         std::string literal(const T& value) const;
+
+         std::string op_name(const std::string& op) const;
+
+         std::string ipow_name(const std::string& n, const std::string& function) const;
+
+         static bool valid_identifier(const std::string& name);
+
+         static std::string number(const int16_t&     value);
+         static std::string number(const int32_t&     value);
+         static std::string number(const int64_t&     value);
+         static std::string number(const float&       value);
+         static std::string number(const double&      value);
+         static std::string number(const long double& value);
+
+         template <typename U>
+         static std::string number(const std::complex<U>& value);
+
+         template <typename U>
+         static std::string integer(const U& value);
+
+         template <typename U>
+         static std::string floating(const U& value, const char* suffix);
+
+         static const char* type_name(const int16_t&);
+         static const char* type_name(const int32_t&);
+         static const char* type_name(const int64_t&);
+         static const char* type_name(const float&);
+         static const char* type_name(const double&);
+         static const char* type_name(const long double&);
+         static const char* type_name(const std::complex<float>&);
+         static const char* type_name(const std::complex<double>&);
+         static const char* type_name(const std::complex<long double>&);
+
+         std::string                    type_;
+         std::vector<symbol>            symbol_list_;
+         std::vector<function_t>        function_list_;
+         std::map<ufunc_t, std::string> unary_name_map_;
+         std::map<bfunc_t, std::string> binary_name_map_;
+         std::map<tfunc_t, std::string> trinary_name_map_;
+         std::map<qfunc_t, std::string> quaternary_name_map_;
+
+         const T*                       register_begin_;
+         const T*                       register_end_;
+         std::vector<bool>              register_written_;
+         local_map_t                    local_map_;
+         std::string                    error_;
+      };
+   }
+}
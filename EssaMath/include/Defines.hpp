@@ -39,6 +39,7 @@
 #include <functional>
 #include <iterator>
 #include <string>
+#include <string_view>
 
 namespace Essa::Math
 {
@@ -94,9 +95,7 @@ namespace Essa::Math
       extern bool disable_superscalar_unroll;
       extern bool disable_comments;
       extern bool disable_return_statement;
-      extern bool disable_enhanced_features;
       extern bool disable_sc_andor;
-      extern bool disable_cardinal_pow_optimisation;
 
       bool is_whitespace(const char_t c);
       bool is_operator_char(const char_t c);
@@ -111,13 +110,23 @@ namespace Essa::Math
       bool is_valid_string_char(const char_t c);
       void case_normalise(std::string& s);
       bool imatch(const char_t c1, const char_t c2);
-      bool imatch(const std::string& s1, const std::string& s2);
+      bool imatch(std::string_view s1, std::string_view s2);
 
       struct ilesscompare
       {
          bool operator() (const std::string& s1, const std::string& s2) const;
       };
 
+      struct ihash
+      {
+         std::size_t operator() (const std::string& s) const;
+      };
+
+      struct iequal_to
+      {
+         bool operator() (const std::string& s1, const std::string& s2) const;
+      };
+
       bool is_valid_sf_symbol(const std::string& symbol);
       const char_t& front(const std::string& s);
       const char_t& back(const std::string& s);
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "include/Bytecode.hpp"
+#include <map>
+#include <vector>
+
+namespace Essa::Math{
+   namespace details
+   {
+      // Seeds a variable for derivative_program::value(): direction[k] is
+      // the derivative of the variable along the k-th direction.
+      template <typename T>
+      struct derivative_seed
+      {
+         derivative_seed(T& var, const T* dir)
+         : variable(&var)
+         , direction(dir)
+         {}
+
+         T*       variable;
+         const T* direction;
+      };
+
+      // The partial derivatives of the functions bytecode programs call,
+      // looked up by the address of the function.
+      template <typename T>
+      class derivative_rules
+      {
+      public:
+
+         typedef bytecode_program<T>             program_t;
+         typedef typename program_t::instruction instruction_t;
+         typedef typename program_t::ufunc_t     ufunc_t;
+         typedef typename program_t::bfunc_t     bfunc_t;
+         typedef typename program_t::tfunc_t     tfunc_t;
+         typedef typename program_t::qfunc_t     qfunc_t;
+
+         // Writes the partial derivative with respect to each argument x[i]
+         // to p[i], r being the value of the function at x.
+         typedef void (*partial_t)(const T* x, const T& r, T* p);
+
+         derivative_rules();
+
+         // Null for instructions that call no function or one without a
+         // rule.
+         partial_t find(const instruction_t& inst) const;
+
+      private:
+
+         std::map<ufunc_t, partial_t> unary_map_;
+         std::map<bfunc_t, partial_t> binary_map_;
+         std::map<tfunc_t, partial_t> trinary_map_;
+         std::map<qfunc_t, partial_t> quaternary_map_;
+      };
+
+      // Evaluates an expression together with its derivatives, propagating
+      // them through the bytecode program the expression lowers to: forward
+      // along any number of directions with value(), or backward to the
+      // gradient with respect to any number of variables with gradient().
+      // Branches and loops are differentiated along the path the values
+      // take. Memory the program reads has to outlive it, as for
+      // bytecode_program.
+      template <typename T>
+      class derivative_program
+      {
+      public:
+
+         typedef bytecode_program<T>              program_t;
+         typedef typename program_t::instruction instruction_t;
+         typedef derivative_seed<T>               seed_t;
+
+         derivative_program();
+
+         // Returns false, leaving the object empty, when the program calls
+         // back into the tree, calls user functions, runs vector operations
+         // or calls a function without a derivative rule.
+         bool compile(const expression_node<T>* root);
+
+         // Returns the value of the expression and writes its derivative
+         // along direction k to derivative[k]. Variables that are not
+         // seeded have derivative zero.
+         T value(const seed_t* seed_list, const std::size_t seed_count,
+                 T* derivative, const std::size_t directions) const;
+
+         // Returns the value of the expression and writes its partial
+         // derivative with respect to variable_list[i] to gradient[i], at a
+         // cost independent of the number of variables: the evaluation
+         // records the partials of each instruction it runs on a tape,
+         // which is then swept backwards accumulating adjoints. The tape
+         // keeps its storage from one call to the next.
+         T gradient(const T* const* variable_list, const std::size_t variable_count,
+                    T* gradient) const;
+
+         bool valid() const;
+
+      private:
+
+         typedef typename derivative_rules<T>::partial_t partial_t;
+         typedef std::map<const T*, std::size_t>         slot_map_t;
+         typedef std::pair<const T*, std::size_t>        variable_slot_t;
+
+         // The derivative slots of the result and the arguments of an
+         // instruction.
+         struct derivative_instruction
+         {
+            std::size_t slot[5];
+            std::size_t arity;
+            partial_t   partial;
+         };
+
+         // The partials of the arguments of an instruction gradient() ran.
+         struct tape_entry
+         {
+            std::size_t instruction;
+            T           partial[4];
+         };
+
+         derivative_program(const derivative_program<T>&) exprtk_delete;
+         derivative_program<T>& operator=(const derivative_program<T>&) exprtk_delete;
+
+         std::size_t slot(const T* address);
+
+         // The slot of a variable, or slot_map_.size() when the program
+         // does not use it.
+         std::size_t variable_slot(const T* variable) const;
+
+         // Directions is the number of directions, or zero to take it from
+         // directions at run time.
+         template <std::size_t Directions>
+         T evaluate(const seed_t* seed_list, const std::size_t seed_count,
+                    T* derivative, const std::size_t directions) const;
+
+         program_t                           program_;
+         std::vector<derivative_instruction> instruction_list_;
+         slot_map_t                          slot_map_;
+         // The slots of memory outside of the register file, in address
+         // order, where variables are looked up.
+         std::vector<variable_slot_t>        variable_slot_list_;
+         mutable std::vector<T>              tangent_;
+         mutable std::vector<tape_entry>     tape_;
+         // The variables of the last call to gradient() and their slots.
+         mutable std::vector<const T*>       gradient_variable_list_;
+         mutable std::vector<std::size_t>    gradient_slot_list_;
+         bool                                valid_;
+      };
+   }
+}
@@ -2,8 +2,10 @@
 
 #include "include/Defines.hpp"
 #include "include/Expression.hpp"
+#include "include/ExpressionCache.hpp"
 #include "include/ExpressionHelper.hpp"
 #include "include/ExpressionNodes.hpp"
+#include "include/ExpressionSet.hpp"
 #include "include/Functions.hpp"
 #include "include/Generator.hpp"
 #include "include/Lexer.hpp"
@@ -31,7 +31,10 @@
 
 #pragma once
 
+#include "include/CodeGenerator.hpp"
+#include "include/Derivative.hpp"
 #include "include/ExpressionNodes.hpp"
+#include "include/Jit.hpp"
 #include "include/OperatorHelpers.hpp"
 #include "include/SymbolTable.hpp"
 
@@ -39,6 +42,12 @@ namespace Essa::Math{
    template <typename T>
    class function_compositor;
 
+   template <typename T>
+   class compiled_expression_cache;
+
+   template <typename T>
+   class expression_set;
+
    template <typename T>
    class expression
    {
@@ -82,10 +91,19 @@ namespace Essa::Math{
          typedef std::vector<data_pack> local_data_list_t;
          typedef results_context<T>     results_context_t;
          typedef control_block*         cntrl_blck_ptr_t;
+         typedef std::function<bool(expression<T>&)> display_builder_t;
 
          control_block()
          : ref_count(0)
          , expr     (0)
+         , display_expr(0)
+         , program  (0)
+         , native   (0)
+         , batch_program(0)
+         , batch_lowered(false)
+         , derivative(0)
+         , derivative_lowered(false)
+         , vector_math(false)
          , results  (0)
          , retinv_null(false)
          , return_invoked(&retinv_null)
@@ -94,6 +112,14 @@ namespace Essa::Math{
          explicit control_block(expression_ptr e)
          : ref_count(1)
          , expr     (e)
+         , display_expr(0)
+         , program  (0)
+         , native   (0)
+         , batch_program(0)
+         , batch_lowered(false)
+         , derivative(0)
+         , derivative_lowered(false)
+         , vector_math(false)
          , results  (0)
          , retinv_null(false)
          , return_invoked(&retinv_null)
@@ -136,6 +162,31 @@ namespace Essa::Math{
             {
                delete results;
             }
+
+            if (display_expr)
+            {
+               delete display_expr;
+            }
+
+            if (native)
+            {
+               delete native;
+            }
+
+            if (program)
+            {
+               delete program;
+            }
+
+            if (batch_program)
+            {
+               delete batch_program;
+            }
+
+            if (derivative)
+            {
+               delete derivative;
+            }
          }
 
          static inline cntrl_blck_ptr_t create(expression_ptr e)
@@ -161,7 +212,15 @@ namespace Essa::Math{
 
          std::size_t ref_count;
          expression_ptr expr;
-         expression_ptr unoptimized_expr;
+         expression<T>* display_expr;
+         display_builder_t display_builder;
+         details::bytecode_program<T>* program;
+         details::jit_program<T>*      native;
+         details::bytecode_program<T>* batch_program;
+         bool batch_lowered;
+         details::derivative_program<T>* derivative;
+         bool derivative_lowered;
+         bool vector_math;
          local_data_list_t local_data_list;
          results_context_t* results;
          bool  retinv_null;
@@ -217,13 +276,17 @@ namespace Essa::Math{
          return *this;
       }
 
-      inline std::string to_string() const{
+      inline std::string to_string() const
+      {
          assert(control_block_      );
-         assert(control_block_->unoptimized_expr);
+         assert(control_block_->expr);
+
+         build_display_tree();
 
-         auto& typ = typeid(control_block_->expr);
+         if (control_block_->display_expr)
+            return control_block_->display_expr->control_block_->expr->to_string();
 
-         return control_block_->unoptimized_expr->to_string();
+         return control_block_->expr->to_string();
       }
 
       inline bool operator==(const expression<T>& e) const
@@ -257,6 +320,12 @@ namespace Essa::Math{
          assert(control_block_      );
          assert(control_block_->expr);
 
+         if (control_block_->native)
+            return control_block_->native->value();
+
+         if (control_block_->program)
+            return control_block_->program->value();
+
          return control_block_->expr->value();
       }
 
@@ -315,7 +384,278 @@ namespace Essa::Math{
       {
          return (*control_block_->return_invoked);
       }
+
+      // Lowers the compiled tree into a bytecode program which value() then
+      // runs in place of the tree walk. Subtrees that have no lowering are
+      // still evaluated by the tree. Returns false, and keeps evaluating the
+      // tree, when the root node itself cannot be lowered. The program keeps
+      // its temporaries in a register file shared by all copies of this
+      // expression, so a lowered expression must not be evaluated from
+      // several threads at once.
+      inline bool lower_to_bytecode()
+      {
+         if ((0 == control_block_) || (0 == control_block_->expr))
+            return false;
+
+         clear_bytecode();
+
+         details::bytecode_program<T>* program = new details::bytecode_program<T>();
+         details::bytecode_builder<T> builder(*program);
+
+         if (!builder.build(control_block_->expr))
+         {
+            delete program;
+            return false;
+         }
+
+         control_block_->program = program;
+
+         return true;
+      }
+
+      inline void clear_bytecode()
+      {
+         clear_native();
+
+         if (control_block_ && control_block_->program)
+         {
+            delete control_block_->program;
+            control_block_->program = 0;
+         }
+      }
+
+      inline const details::bytecode_program<T>* bytecode() const
+      {
+         return control_block_ ? control_block_->program : 0;
+      }
+
+      // Translates the bytecode program, lowering the tree first if that has
+      // not been done yet, into native machine code which value() then runs.
+      // Only double is supported, on x86-64; elsewhere this returns false
+      // and evaluation stays as it was. The restrictions of
+      // lower_to_bytecode() apply to the native code as well.
+      inline bool compile_native()
+      {
+         if (!details::jit_program<T>::supported())
+            return false;
+
+         if ((0 == bytecode()) && !lower_to_bytecode())
+            return false;
+
+         clear_native();
+
+         details::jit_program<T>* native = new details::jit_program<T>();
+
+         if (!native->compile(*control_block_->program))
+         {
+            delete native;
+            return false;
+         }
+
+         control_block_->native = native;
+
+         return true;
+      }
+
+      inline void clear_native()
+      {
+         if (control_block_ && control_block_->native)
+         {
+            delete control_block_->native;
+            control_block_->native = 0;
+         }
+      }
+
+      inline const details::jit_program<T>* native_code() const
+      {
+         return control_block_ ? control_block_->native : 0;
+      }
+
+      // Writes C++ source defining a function of the given name that
+      // computes what value() does, in the form described at
+      // details::cpp_generator. The variables, vectors and functions of the
+      // expression's symbol tables become the members of its symbols struct
+      // and its extern functions, constants become literals. Returns false
+      // for expressions the generator cannot express, such as ones with
+      // subtrees that do not lower to bytecode.
+      inline bool generate_cpp(const std::string& function_name, std::string& source) const
+      {
+         if ((0 == control_block_) || (0 == control_block_->expr))
+            return false;
+
+         details::cpp_generator<T> generator;
+
+         for (std::size_t i = 0; i < symbol_table_list_.size(); ++i)
+         {
+            const symbol_table<T>& st = symbol_table_list_[i];
+            std::vector<std::string> name_list;
+
+            st.get_variable_list(name_list);
+
+            for (std::size_t j = 0; j < name_list.size(); ++j)
+            {
+               if (!st.is_constant_node(name_list[j]))
+                  generator.add_variable(name_list[j], st.get_variable(name_list[j])->ref());
+            }
+
+            name_list.clear();
+            st.get_vector_list(name_list);
+
+            for (std::size_t j = 0; j < name_list.size(); ++j)
+            {
+               typename symbol_table<T>::vector_holder_ptr vector = st.get_vector(name_list[j]);
+               generator.add_vector(name_list[j], vector->data(), vector->size());
+            }
+
+            name_list.clear();
+            st.get_function_list(name_list);
+
+            for (std::size_t j = 0; j < name_list.size(); ++j)
+            {
+               generator.add_function(name_list[j], st.get_function(name_list[j]));
+            }
+         }
+
+         if (bytecode())
+            return generator.generate(*bytecode(), function_name, source);
+
+         details::bytecode_program<T> program;
+         details::bytecode_builder<T> builder(program);
+
+         return builder.build(control_block_->expr) &&
+                generator.generate(program, function_name, source);
+      }
+
+      typedef details::bytecode_column<T> batch_column;
+
+      // Evaluates the expression once per row, where row i takes the i-th
+      // value of each column for the column's variable, and writes rows
+      // results to result. Expressions built from arithmetic, functions,
+      // conditionals and the fused operator nodes are evaluated a block of
+      // rows per instruction. Others, for example ones with loops, user
+      // functions or state carried between rows, are evaluated row by row
+      // and leave each bound variable holding its value from before the
+      // call. Expressions compiled with the parser setting e_vector_math
+      // run exp, log, sin and the other functions of vector_math over a
+      // block at a time with its SIMD kernels.
+      inline void evaluate_batch(const std::vector<batch_column>& column_list,
+                                 T* result,
+                                 const std::size_t rows,
+                                 const std::size_t block_size = 1024)
+      {
+         assert(control_block_      );
+         assert(control_block_->expr);
+
+         if (!control_block_->batch_lowered)
+         {
+            control_block_->batch_lowered = true;
+
+            details::bytecode_program<T>* program = new details::bytecode_program<T>();
+            details::bytecode_builder<T> builder(*program, true);
+
+            if (builder.build(control_block_->expr))
+               control_block_->batch_program = program;
+            else
+               delete program;
+         }
+
+         const batch_column* columns = column_list.empty() ? 0 : &column_list[0];
+
+         if (
+              control_block_->batch_program &&
+              control_block_->batch_program->value_batch(columns, column_list.size(), result, rows, block_size,
+                                                         control_block_->vector_math)
+            )
+         {
+            return;
+         }
+
+         std::vector<T> saved_value_list(column_list.size());
+
+         for (std::size_t i = 0; i < column_list.size(); ++i)
+         {
+            saved_value_list[i] = *column_list[i].variable;
+         }
+
+         for (std::size_t row = 0; row < rows; ++row)
+         {
+            for (std::size_t i = 0; i < column_list.size(); ++i)
+            {
+               *column_list[i].variable = column_list[i].data[row];
+            }
+
+            result[row] = value();
+         }
+
+         for (std::size_t i = 0; i < column_list.size(); ++i)
+         {
+            *column_list[i].variable = saved_value_list[i];
+         }
+      }
       
+      typedef details::derivative_seed<T> derivative_seed;
+
+      // Evaluates the expression together with its derivatives along one
+      // or more directions, with no symbolic differentiation involved.
+      // seed_list[i].direction[k] is the derivative of the variable
+      // seed_list[i].variable along direction k, and derivative[k] receives
+      // that of the expression. Seeding each of n variables with a unit
+      // vector of length n gives the gradient. Conditionals and loops are
+      // differentiated along the path the evaluation takes. Returns false,
+      // writing nothing, for expressions with subtrees that do not lower to
+      // bytecode, user functions, vector operations or functions without a
+      // derivative rule.
+      inline bool derivative(const std::vector<derivative_seed>& seed_list,
+                             T& value,
+                             T* derivative,
+                             const std::size_t directions = 1)
+      {
+         const details::derivative_program<T>* program = lowered_derivative();
+
+         if (0 == program)
+            return false;
+
+         const derivative_seed* seeds = seed_list.empty() ? 0 : &seed_list[0];
+
+         value = program->value(seeds, seed_list.size(), derivative, directions);
+
+         return true;
+      }
+
+      // The derivative with respect to a single variable.
+      inline bool derivative(T& variable, T& value, T& derivative)
+      {
+         const details::derivative_program<T>* program = lowered_derivative();
+
+         if (0 == program)
+            return false;
+
+         const T direction = T(1);
+         const derivative_seed seed(variable, &direction);
+
+         value = program->value(&seed, 1, &derivative, 1);
+
+         return true;
+      }
+
+      // Evaluates the expression and writes its partial derivative with
+      // respect to variable_list[i] to gradient[i]. Where derivative() costs
+      // an evaluation per seeded variable, this costs a few evaluations
+      // however many variables there are, which suits optimisers over many
+      // parameters. Returns false, writing nothing, where derivative() does.
+      inline bool gradient(const std::vector<T*>& variable_list, T& value, T* gradient)
+      {
+         const details::derivative_program<T>* program = lowered_derivative();
+
+         if (0 == program)
+            return false;
+
+         const T* const* variables = variable_list.empty() ? 0 : &variable_list[0];
+
+         value = program->gradient(variables, variable_list.size(), gradient);
+
+         return true;
+      }
 
    private:
 
@@ -340,16 +680,49 @@ namespace Essa::Math{
          }
       }
 
-      inline void set_unoptimized_expr(const expression_ptr expr)
+      inline const details::derivative_program<T>* lowered_derivative()
       {
-         if (expr)
+         assert(control_block_      );
+         assert(control_block_->expr);
+
+         if (!control_block_->derivative_lowered)
          {
-            if (!control_block_)
-            {
-               control_block_ = control_block::create(expr);
-            }
+            control_block_->derivative_lowered = true;
 
-            control_block_->unoptimized_expr = expr;
+            details::derivative_program<T>* program = new details::derivative_program<T>();
+
+            if (program->compile(control_block_->expr))
+               control_block_->derivative = program;
+            else
+               delete program;
+         }
+
+         return control_block_->derivative;
+      }
+
+      // The display tree is only parsed the first time it is asked for,
+      // compile() itself builds nothing but the optimised tree.
+      inline void build_display_tree() const
+      {
+         if (control_block_ && !control_block_->display_expr && control_block_->display_builder)
+         {
+            expression<T>* display = new expression<T>();
+            display->symbol_table_list_ = symbol_table_list_;
+
+            if (control_block_->display_builder(*display))
+               control_block_->display_expr = display;
+            else
+               delete display;
+
+            control_block_->display_builder = typename control_block::display_builder_t();
+         }
+      }
+
+      inline void set_display_builder(const typename control_block::display_builder_t& builder)
+      {
+         if (control_block_)
+         {
+            control_block_->display_builder = builder;
          }
       }
 
@@ -435,11 +808,21 @@ namespace Essa::Math{
          }
       }
 
+      inline void set_vector_math(const bool enabled)
+      {
+         if (control_block_)
+         {
+            control_block_->vector_math = enabled;
+         }
+      }
+
       control_block* control_block_;
       symtab_list_t  symbol_table_list_;
 
       friend class parser<T>;
       friend class expression_helper<T>;
       friend class function_compositor<T>;
+      friend class compiled_expression_cache<T>;
+      friend class expression_set<T>;
    }; // class expression
 }
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "include/Expression.hpp"
+#include "include/Parser.hpp"
+#include "include/SymbolTable.hpp"
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace Essa::Math{
+   template <typename T>
+   class compiled_expression_cache
+   {
+   public:
+
+      typedef expression<T>   expression_t;
+      typedef parser<T>       parser_t;
+      typedef symbol_table<T> symbol_table_t;
+
+      struct statistics
+      {
+         statistics()
+         : hits     (0)
+         , misses   (0)
+         , evictions(0)
+         {}
+
+         std::size_t hits;
+         std::size_t misses;
+         std::size_t evictions;
+      };
+
+      explicit compiled_expression_cache(const std::size_t capacity = 1024)
+      : capacity_(capacity)
+      {}
+
+      // Looks the expression up by its text and by the symbol tables
+      // registered with expr. On a hit expr shares the cached control
+      // block, on a miss the string is compiled with p and remembered.
+      bool compile(parser_t& p, const std::string& expression_string, expression_t& expr)
+      {
+         const typename entry_list_t::iterator itr = find(expression_string, expr);
+
+         if (entry_list_.end() != itr)
+         {
+            ++stats_.hits;
+            entry_list_.splice(entry_list_.begin(), entry_list_, itr);
+            expr = itr->expr;
+
+            return true;
+         }
+
+         ++stats_.misses;
+
+         if (!p.compile(expression_string, expr))
+         {
+            return false;
+         }
+
+         if (0 == capacity_)
+         {
+            return true;
+         }
+
+         while (entry_list_.size() >= capacity_)
+         {
+            evict_last();
+         }
+
+         entry_list_.push_front(entry(expression_string, expr));
+         index_.insert(std::make_pair(expression_string, entry_list_.begin()));
+
+         return true;
+      }
+
+      expression_t compile(parser_t& p, const std::string& expression_string, symbol_table_t& symtab)
+      {
+         expression_t expr;
+         expr.register_symbol_table(symtab);
+         compile(p, expression_string, expr);
+         return expr;
+      }
+
+      bool contains(const std::string& expression_string, const expression_t& expr) const
+      {
+         return entry_list_.end() != find(expression_string, expr);
+      }
+
+      void clear()
+      {
+         index_     .clear();
+         entry_list_.clear();
+      }
+
+      void set_capacity(const std::size_t capacity)
+      {
+         capacity_ = capacity;
+
+         while (entry_list_.size() > capacity_)
+         {
+            evict_last();
+         }
+      }
+
+      std::size_t capacity() const
+      {
+         return capacity_;
+      }
+
+      std::size_t size() const
+      {
+         return entry_list_.size();
+      }
+
+      const statistics& stats() const
+      {
+         return stats_;
+      }
+
+      void reset_stats()
+      {
+         stats_ = statistics();
+      }
+
+   private:
+
+      struct entry
+      {
+         entry(const std::string& s, const expression_t& e)
+         : expression_string(s)
+         , expr(e)
+         {}
+
+         std::string  expression_string;
+         expression_t expr;
+      };
+
+      typedef std::list<entry> entry_list_t;
+      typedef std::unordered_multimap<std::string, typename entry_list_t::iterator> index_t;
+
+      static bool same_symbol_tables(const expression_t& e0, const expression_t& e1)
+      {
+         const typename expression_t::symtab_list_t& l0 = e0.symbol_table_list_;
+         const typename expression_t::symtab_list_t& l1 = e1.symbol_table_list_;
+
+         if (l0.size() != l1.size())
+            return false;
+
+         for (std::size_t i = 0; i < l0.size(); ++i)
+         {
+            if (!(l0[i] == l1[i]))
+               return false;
+         }
+
+         return true;
+      }
+
+      typename entry_list_t::iterator find(const std::string& expression_string, const expression_t& expr)
+      {
+         std::pair<typename index_t::iterator, typename index_t::iterator> range = index_.equal_range(expression_string);
+
+         for (typename index_t::iterator itr = range.first; itr != range.second; ++itr)
+         {
+            if (same_symbol_tables(itr->second->expr, expr))
+               return itr->second;
+         }
+
+         return entry_list_.end();
+      }
+
+      typename entry_list_t::const_iterator find(const std::string& expression_string, const expression_t& expr) const
+      {
+         return const_cast<compiled_expression_cache<T>*>(this)->find(expression_string, expr);
+      }
+
+      void evict_last()
+      {
+         const typename entry_list_t::iterator last = --entry_list_.end();
+
+         std::pair<typename index_t::iterator, typename index_t::iterator> range = index_.equal_range(last->expression_string);
+
+         for (typename index_t::iterator itr = range.first; itr != range.second; ++itr)
+         {
+            if (itr->second == last)
+            {
+               index_.erase(itr);
+               break;
+            }
+         }
+
+         entry_list_.erase(last);
+         ++stats_.evictions;
+      }
+
+      std::size_t  capacity_;
+      entry_list_t entry_list_;
+      index_t      index_;
+      statistics   stats_;
+   };
+}
@@ -40,6 +40,8 @@
 #include "include/NodeAllocator.hpp"
 #include "include/Functions.hpp"
 #include "include/SymbolTable.hpp"
+#include <chrono>
+#include <set>
 
 namespace Essa::Math{
       template <typename T>
@@ -105,6 +107,9 @@ namespace Essa::Math{
         typedef details::conditional_vector_node<T>         conditional_vector_node_t;
         typedef details::scand_node<T>                      scand_node_t;
         typedef details::scor_node<T>                       scor_node_t;
+        typedef details::shared_expression_node<T>          shared_expression_node_t;
+        typedef details::shared_reference_node<T>           shared_reference_node_t;
+        typedef details::memo_node<T>                       memo_node_t;
         typedef lexer::token                                token_t;
         typedef details::vector_holder<T>*                  vector_holder_ptr;
 
@@ -188,6 +193,16 @@ namespace Essa::Math{
 
          bool strength_reduction_enabled() const;
 
+         void set_enhanced_features_state(const bool enabled);
+
+         bool enhanced_features_enabled() const;
+
+         void set_cardinal_pow_optimisation_state(const bool enabled);
+
+         bool cardinal_pow_optimisation_enabled() const;
+
+         void set_synthesis_time(double* synthesis_time);
+
          bool valid_operator(const details::operator_type& operation, binary_functor_t& bop);
 
          bool valid_operator(const details::operator_type& operation, unary_functor_t& uop);
@@ -428,6 +443,7 @@ namespace Essa::Math{
                    template <typename, typename> class Sequence>
          expression_node_ptr switch_statement(Sequence<expression_node_ptr,Allocator>& arg_list, const bool default_statement_present)
          {
+            synthesis_timer timer(*this);
             if (arg_list.empty())
                return error_node();
             else if (
@@ -467,6 +483,7 @@ namespace Essa::Math{
                    template <typename, typename> class Sequence>
          expression_node_ptr multi_switch_statement(Sequence<expression_node_ptr,Allocator>& arg_list)
          {
+            synthesis_timer timer(*this);
             if (!all_nodes_valid(arg_list))
             {
                details::free_all_nodes(*node_allocator_,arg_list);
@@ -630,6 +647,7 @@ namespace Essa::Math{
                    template <typename, typename> class Sequence>
          expression_node_ptr vararg_function(const details::operator_type& operation, Sequence<expression_node_ptr,Allocator>& arg_list)
          {
+            synthesis_timer timer(*this);
             if (!all_nodes_valid(arg_list))
             {
                details::free_all_nodes(*node_allocator_,arg_list);
@@ -674,6 +692,7 @@ namespace Essa::Math{
          template <std::size_t N>
          expression_node_ptr function(ifunction_t* f, expression_node_ptr (&b)[N])
          {
+            synthesis_timer timer(*this);
             typedef typename details::function_N_node<T,ifunction_t,N> function_N_node_t;
             expression_node_ptr result = synthesize_expression<function_N_node_t,N>(f,b);
 
@@ -742,12 +761,112 @@ namespace Essa::Math{
                                                    vector_holder_ptr vector_base,
                                                    expression_node_ptr index);
 
+         // Replaces subtrees without side effects that occur more than once
+         // by references to a single copy, evaluated at most once each time
+         // the returned root is. Returns root itself when nothing is shared.
+         expression_node_ptr share_common_subexpressions(expression_node_ptr root);
+
+         // Wraps subtrees without side effects in memo nodes that keep their
+         // value until memory the subtree reads changes. A subtree is wrapped
+         // when it is the root, or when it reads less than the nearest
+         // subtree above it that can be memoised, so a change of one variable
+         // only re-evaluates the path of nodes depending on it.
+         expression_node_ptr memoise(expression_node_ptr root);
+
+         // Moves subtrees of a loop that write no memory and read none the
+         // loop writes into a shared_expression_node around the loop, which
+         // evaluates each of them at most once each time the loop is entered,
+         // on the first iteration reaching it. Inner loops are done first,
+         // so what they hoist can move further out.
+         expression_node_ptr hoist_loop_invariants(expression_node_ptr root);
+
       private:
 
+         // Subtrees computing the same value from the same memory. Nodes
+         // are keyed by their own bytecode with each child replaced by a
+         // variable reading the placeholder of the child's class.
+         struct subexpression_class
+         {
+            T           placeholder;
+            std::size_t cost;
+            std::size_t count;
+            bool        share;
+
+            const details::shared_subexpression<T>* shared;
+
+            // Sorted memory the subtree reads, placeholders excluded.
+            std::vector<const T*> read_list;
+         };
+
+         struct subexpression_state
+         {
+            std::map<expression_node_ptr,std::size_t> class_map;
+            std::map<std::string,std::size_t>         key_map;
+            std::deque<subexpression_class>           class_list;
+            std::set<const T*>                        write_set;
+            shared_expression_node_t*                 root;
+         };
+
+         std::size_t classify_subexpression(expression_node_ptr node, subexpression_state& state);
+
+         void count_subexpression(expression_node_ptr node, subexpression_state& state);
+
+         void share_subexpression(expression_node_ptr& node, subexpression_state& state);
+
+         bool analyse_subexpressions(expression_node_ptr root, subexpression_state& state);
+
+         void memoise_subexpression(expression_node_ptr& node, const std::size_t parent, subexpression_state& state);
+
+         void hoist_loop_invariant(expression_node_ptr& node);
+
+         void mark_loop_invariant(expression_node_ptr node, subexpression_state& state, bool& marked);
+
+         // Adds the memory node writes to write_set. Returns false when that
+         // cannot be told.
+         bool loop_write_set(expression_node_ptr node, std::set<const T*>& write_set);
+
+         // Accumulates the wall time of the outermost synthesis call into
+         // synthesis_time_, nested calls made while building that node are
+         // already covered by it.
+         class synthesis_timer
+         {
+         public:
+
+            explicit synthesis_timer(const expression_generator<T>& expr_gen)
+            : expr_gen_(expr_gen)
+            , active_((0 != expr_gen.synthesis_time_) && !expr_gen.synthesis_active_)
+            {
+               if (active_)
+               {
+                  expr_gen_.synthesis_active_ = true;
+                  start_ = std::chrono::steady_clock::now();
+               }
+            }
+
+           ~synthesis_timer()
+            {
+               if (active_)
+               {
+                  *expr_gen_.synthesis_time_ +=
+                     std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+                  expr_gen_.synthesis_active_ = false;
+               }
+            }
+
+         private:
+
+            synthesis_timer(const synthesis_timer&) exprtk_delete;
+            synthesis_timer& operator=(const synthesis_timer&) exprtk_delete;
+
+            const expression_generator<T>& expr_gen_;
+            const bool active_;
+            std::chrono::steady_clock::time_point start_;
+         };
+
          template <std::size_t N, typename NodePtr>
          bool is_constant_foldable(NodePtr (&b)[N]) const
          {
-            if(details::disable_enhanced_features)
+            if (!enhanced_features_enabled_)
                return false;
             for (std::size_t i = 0; i < N; ++i)
             {
@@ -765,7 +884,7 @@ namespace Essa::Math{
                    template <typename, typename> class Sequence>
          bool is_constant_foldable(const Sequence<NodePtr,Allocator>& b) const
          {
-            if(details::disable_enhanced_features)
+            if (!enhanced_features_enabled_)
                return false;
             for (std::size_t i = 0; i < b.size(); ++i)
             {
@@ -1037,6 +1156,8 @@ namespace Essa::Math{
          }
 
          bool                     strength_reduction_enabled_;
+         bool                     enhanced_features_enabled_;
+         bool                     cardinal_pow_optimisation_enabled_;
          details::node_allocator* node_allocator_;
          synthesize_map_t         synthesize_map_;
          unary_op_map_t*          unary_op_map_;
@@ -1045,5 +1166,7 @@ namespace Essa::Math{
          sf3_map_t*               sf3_map_;
          sf4_map_t*               sf4_map_;
          parser_t*                parser_;
+         double*                  synthesis_time_;
+         mutable bool             synthesis_active_;
       }; // class expression_generator
 }
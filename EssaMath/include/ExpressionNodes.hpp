@@ -33,9 +33,13 @@
 
 #include "include/ParserHelpers.hpp"
 #include "include/OperatorHelpers.hpp"
+#include "include/Bytecode.hpp"
+#include "include/VectorKernels.hpp"
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <cassert>
+#include <type_traits>
 
 namespace Essa::Math{
    namespace details
@@ -284,7 +288,8 @@ namespace Essa::Math{
             e_vecopvecass   , e_vecfunc       , e_vecvecswap  , e_vecvecineq   ,
             e_vecvalineq    , e_valvecineq    , e_vecvecarith , e_vecvalarith  ,
             e_valvecarith   , e_vecunaryop    , e_vecondition , e_break        ,
-            e_continue      , e_swap
+            e_continue      , e_swap          , e_sharedexpr  , e_sharedref    ,
+            e_memo
          };
 
          typedef T value_type;
@@ -313,6 +318,13 @@ namespace Essa::Math{
          inline virtual std::string to_string() const {
             return "";
          }
+
+         // Emits the node into a bytecode program. Nodes that return false
+         // are evaluated through value() by the program instead.
+         inline virtual bool lower(bytecode_builder<T>&, std::size_t&) const
+         {
+            return false;
+         }
       }; // class expression_node
 
       template <typename T>
@@ -459,6 +471,12 @@ namespace Essa::Math{
             return reinterpret_cast<expression_node<T>*>(0);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.constant(value_);
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             const typename details::numeric::details::number_type<T>::type num_type;
             static const T local_pi = details::numeric::details::const_pi_impl<T>(num_type);
@@ -782,6 +800,17 @@ namespace Essa::Math{
                return reinterpret_cast<expression_ptr>(0);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const expression_node<T>* branch_list[] = { branch_[0].first, branch_[1].first };
+            std::size_t operand[2];
+
+            builder.lower(branch_list, operand, 2);
+            result = builder.binary(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), operand[0], operand[1]);
+
+            return true;
+         }
+
          void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
          {
             expression_node<T>::ndb_t::template collect(branch_, node_delete_list);
@@ -990,6 +1019,37 @@ namespace Essa::Math{
                (condition_, consequent_, alternative_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (builder.branch_free())
+            {
+               const std::size_t side_effects = builder.side_effects();
+
+               const expression_node<T>* branch_list[] = { condition_.first, consequent_.first, alternative_.first };
+               std::size_t operand[3];
+
+               builder.lower(branch_list, operand, 3);
+
+               if (side_effects != builder.side_effects())
+                  return false;
+
+               result = builder.select(operand[0], operand[1], operand[2]);
+
+               return true;
+            }
+
+            result = builder.temporary();
+
+            const std::size_t jump_alternative = builder.jump_false(builder.lower(condition_.first));
+            builder.move(result, builder.lower(consequent_.first));
+            const std::size_t jump_end = builder.jump();
+            builder.patch(jump_alternative, builder.position());
+            builder.move(result, builder.lower(alternative_.first));
+            builder.patch(jump_end, builder.position());
+
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(conditional_node)";
          }
@@ -1044,6 +1104,37 @@ namespace Essa::Math{
                compute_node_depth(condition_, consequent_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (builder.branch_free())
+            {
+               const std::size_t side_effects = builder.side_effects();
+
+               const expression_node<T>* branch_list[] = { condition_.first, consequent_.first };
+               std::size_t operand[2];
+
+               builder.lower(branch_list, operand, 2);
+
+               if (side_effects != builder.side_effects())
+                  return false;
+
+               result = builder.select(operand[0], operand[1], builder.constant(std::numeric_limits<T>::quiet_NaN()));
+
+               return true;
+            }
+
+            result = builder.temporary();
+
+            const std::size_t jump_alternative = builder.jump_false(builder.lower(condition_.first));
+            builder.move(result, builder.lower(consequent_.first));
+            const std::size_t jump_end = builder.jump();
+            builder.patch(jump_alternative, builder.position());
+            builder.move(result, builder.constant(std::numeric_limits<T>::quiet_NaN()));
+            builder.patch(jump_end, builder.position());
+
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(cons_conditional_node)";
          }
@@ -1227,6 +1318,19 @@ namespace Essa::Math{
             return expression_node<T>::ndb_t::compute_node_depth(condition_, loop_body_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.copy(builder.constant(T(0)));
+
+            const std::size_t loop_start = builder.position();
+            const std::size_t jump_end   = builder.jump_false(builder.lower(condition_.first));
+            builder.move(result, builder.lower(loop_body_.first));
+            builder.jump(loop_start);
+            builder.patch(jump_end, builder.position());
+
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(while_loop_node)";
          }
@@ -1270,6 +1374,11 @@ namespace Essa::Math{
 
             return result;
          }
+
+         inline bool lower(bytecode_builder<T>&, std::size_t&) const exprtk_override
+         {
+            return false;
+         }
       };
 
       template <typename T>
@@ -1319,6 +1428,17 @@ namespace Essa::Math{
             return expression_node<T>::ndb_t::compute_node_depth(condition_, loop_body_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.temporary();
+
+            const std::size_t loop_start = builder.position();
+            builder.move(result, builder.lower(loop_body_.first));
+            builder.jump_false(builder.lower(condition_.first), loop_start);
+
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(repeat_until_loop_node)";
          }
@@ -1363,6 +1483,11 @@ namespace Essa::Math{
             return result;
          }
 
+         inline bool lower(bytecode_builder<T>&, std::size_t&) const exprtk_override
+         {
+            return false;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(repeat_until_loop_rtc_node)";
          }
@@ -1435,6 +1560,26 @@ namespace Essa::Math{
                (initialiser_, condition_, incrementor_, loop_body_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.copy(builder.constant(T(0)));
+
+            if (initialiser_.first)
+               builder.lower(initialiser_.first);
+
+            const std::size_t loop_start = builder.position();
+            const std::size_t jump_end   = builder.jump_false(builder.lower(condition_.first));
+            builder.move(result, builder.lower(loop_body_.first));
+
+            if (incrementor_.first)
+               builder.lower(incrementor_.first);
+
+            builder.jump(loop_start);
+            builder.patch(jump_end, builder.position());
+
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(for_loop_node)";
          }
@@ -1497,6 +1642,11 @@ namespace Essa::Math{
             return result;
          }
 
+         inline bool lower(bytecode_builder<T>&, std::size_t&) const exprtk_override
+         {
+            return false;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(for_loop_rtc_node)";
          }
@@ -1539,6 +1689,11 @@ namespace Essa::Math{
             return result;
          }
 
+         inline bool lower(bytecode_builder<T>&, std::size_t&) const exprtk_override
+         {
+            return false;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(while_loop_bc_node)";
          }
@@ -1630,6 +1785,11 @@ namespace Essa::Math{
             return result;
          }
 
+         inline bool lower(bytecode_builder<T>&, std::size_t&) const exprtk_override
+         {
+            return false;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(repeat_until_loop_bc_node)";
          }
@@ -1747,6 +1907,11 @@ namespace Essa::Math{
             return result;
          }
 
+         inline bool lower(bytecode_builder<T>&, std::size_t&) const exprtk_override
+         {
+            return false;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(for_loop_bc_node)";
          }
@@ -1880,6 +2045,64 @@ namespace Essa::Math{
                return std::numeric_limits<T>::quiet_NaN();
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (arg_list_.empty())
+               return false;
+
+            const std::size_t upper_bound = (arg_list_.size() - 1);
+
+            if (builder.branch_free())
+            {
+               const std::size_t side_effects = builder.side_effects();
+
+               std::vector<const expression_node<T>*> branch_list(arg_list_.size());
+               std::vector<std::size_t> operand(arg_list_.size());
+
+               for (std::size_t i = 0; i < arg_list_.size(); ++i)
+               {
+                  branch_list[i] = arg_list_[i].first;
+               }
+
+               builder.lower(&branch_list[0], &operand[0], branch_list.size());
+
+               if (side_effects != builder.side_effects())
+                  return false;
+
+               result = operand[upper_bound];
+
+               for (std::size_t i = upper_bound; i > 0; i -= 2)
+               {
+                  result = builder.select(operand[i - 2], operand[i - 1], result);
+               }
+
+               return true;
+            }
+
+            result = builder.temporary();
+
+            std::vector<std::size_t> jump_end_list;
+
+            for (std::size_t i = 0; i < upper_bound; i += 2)
+            {
+               const std::size_t jump_next = builder.jump_false(builder.lower(arg_list_[i].first));
+               builder.move(result, builder.lower(arg_list_[i + 1].first));
+               jump_end_list.push_back(builder.jump());
+               builder.patch(jump_next, builder.position());
+            }
+
+            builder.move(result, builder.lower(arg_list_[upper_bound].first));
+
+            const std::size_t end = builder.position();
+
+            for (std::size_t i = 0; i < jump_end_list.size(); ++i)
+            {
+               builder.patch(jump_end_list[i], end);
+            }
+
+            return true;
+         }
+
          inline typename expression_node<T>::node_type type() const exprtk_override exprtk_final
          {
             return expression_node<T>::e_switch;
@@ -2054,6 +2277,12 @@ namespace Essa::Math{
             return expression_node<T>::e_variable;
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.reference(*value_);
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return id_.empty() ? numeric::num_to_string<T>(*value_) : id_;
          }
@@ -4628,6 +4857,23 @@ namespace Essa::Math{
             return SpecialFunction::process(x, y, z);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const expression_node<T>* branch_list[] =
+               {
+                  trinary_node<T>::branch_[0].first,
+                  trinary_node<T>::branch_[1].first,
+                  trinary_node<T>::branch_[2].first
+               };
+
+            std::size_t operand[3];
+
+            builder.lower(branch_list, operand, 3);
+            result = builder.trinary(&SpecialFunction::process, operand[0], operand[1], operand[2]);
+
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(sf3_node)";
          }
@@ -4663,6 +4909,24 @@ namespace Essa::Math{
             return SpecialFunction::process(x, y, z, w);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const expression_node<T>* branch_list[] =
+               {
+                  quaternary_node<T>::branch_[0].first,
+                  quaternary_node<T>::branch_[1].first,
+                  quaternary_node<T>::branch_[2].first,
+                  quaternary_node<T>::branch_[3].first
+               };
+
+            std::size_t operand[4];
+
+            builder.lower(branch_list, operand, 4);
+            result = builder.quaternary(&SpecialFunction::process, operand[0], operand[1], operand[2], operand[3]);
+
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(sf4_node)";
          }
@@ -4691,6 +4955,15 @@ namespace Essa::Math{
             return expression_node<T>::e_trinary;
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.trinary(&SpecialFunction::process,
+                                     builder.reference(v0_),
+                                     builder.reference(v1_),
+                                     builder.reference(v2_));
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(sf3_var_node)";
          }
@@ -4728,6 +5001,16 @@ namespace Essa::Math{
             return expression_node<T>::e_trinary;
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.quaternary(&SpecialFunction::process,
+                                        builder.reference(v0_),
+                                        builder.reference(v1_),
+                                        builder.reference(v2_),
+                                        builder.reference(v3_));
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(sf4_var_node)";
          }
@@ -4742,6 +5025,9 @@ namespace Essa::Math{
          const T& v3_;
       };
 
+      template <typename T>
+      struct vararg_multi_op;
+
       template <typename T, typename VarArgFunction>
       class vararg_node exprtk_final : public expression_node<T>
       {
@@ -4790,6 +5076,21 @@ namespace Essa::Math{
             return expression_node<T>::ndb_t::compute_node_depth(arg_list_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (!std::is_same<VarArgFunction, vararg_multi_op<T> >::value || arg_list_.empty())
+               return false;
+
+            for (std::size_t i = 0; i < (arg_list_.size() - 1); ++i)
+            {
+               builder.lower(arg_list_[i].first);
+            }
+
+            result = builder.lower(arg_list_.back().first);
+
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(vararg_node)";
          }
@@ -4941,6 +5242,17 @@ namespace Essa::Math{
                return std::numeric_limits<T>::quiet_NaN();
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (0 == var_node_ptr_)
+               return false;
+
+            const std::size_t value = builder.lower(branch(1));
+            result = builder.move(builder.reference(var_node_ptr_->ref()), value);
+
+            return true;
+         }
+
       private:
 
          variable_node<T>* var_node_ptr_;
@@ -5391,6 +5703,18 @@ namespace Essa::Math{
                return std::numeric_limits<T>::quiet_NaN();
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (0 == var_node_ptr_)
+               return false;
+
+            const std::size_t value = builder.lower(branch(1));
+            const std::size_t var   = builder.reference(var_node_ptr_->ref());
+            result = builder.binary(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), var, value, var);
+
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(assignment_op_node)";
          }
@@ -5538,6 +5862,7 @@ namespace Essa::Math{
          typedef expression_node<T>* expression_ptr;
          typedef vector_node<T>*     vector_node_ptr;
          typedef vec_data_store<T>   vds_t;
+         typedef typename vector_kernels<T>::vecval_t kernel_t;
 
          using binary_node<T>::branch;
 
@@ -5546,7 +5871,11 @@ namespace Essa::Math{
                                 expression_ptr branch1)
          : binary_node<T>(opr, branch0, branch1)
          , vec_node_ptr_(0)
+         , kernel_      (vector_kernels<T>::vecval(Operation::operation()))
          {
+            if (0 == kernel_)
+               kernel_ = &scalar_kernel;
+
             if (is_vector_node(branch(0)))
             {
                vec_node_ptr_ = static_cast<vector_node<T>*>(branch(0));
@@ -5564,50 +5893,56 @@ namespace Essa::Math{
 
                T* vec = vds().data();
 
-               loop_unroll::details lud(size());
-               const T* upper_bound = vec + lud.upper_bound;
+               vector_kernels<T>::run(kernel_, vec, v, vec, size());
 
-               while (vec < upper_bound)
-               {
-                  #define exprtk_loop(N)       \
-                  Operation::assign(vec[N],v); \
+               return vec_node_ptr_->value();
+            }
+            else
+               return std::numeric_limits<T>::quiet_NaN();
+         }
 
-                  exprtk_loop( 0) exprtk_loop( 1)
-                  exprtk_loop( 2) exprtk_loop( 3)
-                  exprtk_loop( 4) exprtk_loop( 5)
-                  exprtk_loop( 6) exprtk_loop( 7)
-                  exprtk_loop( 8) exprtk_loop( 9)
-                  exprtk_loop(10) exprtk_loop(11)
-                  exprtk_loop(12) exprtk_loop(13)
-                  exprtk_loop(14) exprtk_loop(15)
+         // In place, vec is also the source.
+         static void scalar_kernel(const T*, const T& v, T* vec, const std::size_t size)
+         {
+            loop_unroll::details lud(size);
+            const T* upper_bound = vec + lud.upper_bound;
 
-                  vec += lud.batch_size;
-               }
+            while (vec < upper_bound)
+            {
+               #define exprtk_loop(N)       \
+               Operation::assign(vec[N],v); \
 
-               exprtk_disable_fallthrough_begin
-               switch (lud.remainder)
-               {
-                  #define case_stmt(N)                  \
-                  case N : Operation::assign(*vec++,v); \
+               exprtk_loop( 0) exprtk_loop( 1)
+               exprtk_loop( 2) exprtk_loop( 3)
+               exprtk_loop( 4) exprtk_loop( 5)
+               exprtk_loop( 6) exprtk_loop( 7)
+               exprtk_loop( 8) exprtk_loop( 9)
+               exprtk_loop(10) exprtk_loop(11)
+               exprtk_loop(12) exprtk_loop(13)
+               exprtk_loop(14) exprtk_loop(15)
 
-                  case_stmt(15) case_stmt(14)
-                  case_stmt(13) case_stmt(12)
-                  case_stmt(11) case_stmt(10)
-                  case_stmt( 9) case_stmt( 8)
-                  case_stmt( 7) case_stmt( 6)
-                  case_stmt( 5) case_stmt( 4)
-                  case_stmt( 3) case_stmt( 2)
-                  case_stmt( 1)
-               }
-               exprtk_disable_fallthrough_end
+               vec += lud.batch_size;
+            }
 
-               #undef exprtk_loop
-               #undef case_stmt
+            exprtk_disable_fallthrough_begin
+            switch (lud.remainder)
+            {
+               #define case_stmt(N)                  \
+               case N : Operation::assign(*vec++,v); \
 
-               return vec_node_ptr_->value();
+               case_stmt(15) case_stmt(14)
+               case_stmt(13) case_stmt(12)
+               case_stmt(11) case_stmt(10)
+               case_stmt( 9) case_stmt( 8)
+               case_stmt( 7) case_stmt( 6)
+               case_stmt( 5) case_stmt( 4)
+               case_stmt( 3) case_stmt( 2)
+               case_stmt( 1)
             }
-            else
-               return std::numeric_limits<T>::quiet_NaN();
+            exprtk_disable_fallthrough_end
+
+            #undef exprtk_loop
+            #undef case_stmt
          }
 
          vector_node_ptr vec() const exprtk_override
@@ -5652,6 +5987,7 @@ namespace Essa::Math{
 
          vector_node<T>* vec_node_ptr_;
          vds_t           vds_;
+         kernel_t        kernel_;
       };
 
       template <typename T, typename Operation>
@@ -5664,6 +6000,7 @@ namespace Essa::Math{
          typedef expression_node<T>* expression_ptr;
          typedef vector_node<T>*     vector_node_ptr;
          typedef vec_data_store<T>   vds_t;
+         typedef typename vector_kernels<T>::vecvec_t kernel_t;
 
          using binary_node<T>::branch;
 
@@ -5674,7 +6011,11 @@ namespace Essa::Math{
          , vec0_node_ptr_(0)
          , vec1_node_ptr_(0)
          , initialised_(false)
+         , kernel_     (vector_kernels<T>::vecvec(Operation::operation()))
          {
+            if (0 == kernel_)
+               kernel_ = &scalar_kernel;
+
             if (is_vector_node(branch(0)))
             {
                vec0_node_ptr_ = static_cast<vector_node<T>*>(branch(0));
@@ -5717,53 +6058,59 @@ namespace Essa::Math{
                      T* vec0 = vec0_node_ptr_->vds().data();
                const T* vec1 = vec1_node_ptr_->vds().data();
 
-               loop_unroll::details lud(size());
-               const T* upper_bound = vec0 + lud.upper_bound;
+               vector_kernels<T>::run(kernel_, vec0, vec1, vec0, size());
 
-               while (vec0 < upper_bound)
-               {
-                  #define exprtk_loop(N)                          \
-                  vec0[N] = Operation::process(vec0[N], vec1[N]); \
+               return vec0_node_ptr_->value();
+            }
+            else
+               return std::numeric_limits<T>::quiet_NaN();
+         }
 
-                  exprtk_loop( 0) exprtk_loop( 1)
-                  exprtk_loop( 2) exprtk_loop( 3)
-                  exprtk_loop( 4) exprtk_loop( 5)
-                  exprtk_loop( 6) exprtk_loop( 7)
-                  exprtk_loop( 8) exprtk_loop( 9)
-                  exprtk_loop(10) exprtk_loop(11)
-                  exprtk_loop(12) exprtk_loop(13)
-                  exprtk_loop(14) exprtk_loop(15)
+         // In place, vec0 is also the first source.
+         static void scalar_kernel(const T*, const T* vec1, T* vec0, const std::size_t size)
+         {
+            loop_unroll::details lud(size);
+            const T* upper_bound = vec0 + lud.upper_bound;
 
-                  vec0 += lud.batch_size;
-                  vec1 += lud.batch_size;
-               }
+            while (vec0 < upper_bound)
+            {
+               #define exprtk_loop(N)                          \
+               vec0[N] = Operation::process(vec0[N], vec1[N]); \
 
-               int i = 0;
+               exprtk_loop( 0) exprtk_loop( 1)
+               exprtk_loop( 2) exprtk_loop( 3)
+               exprtk_loop( 4) exprtk_loop( 5)
+               exprtk_loop( 6) exprtk_loop( 7)
+               exprtk_loop( 8) exprtk_loop( 9)
+               exprtk_loop(10) exprtk_loop(11)
+               exprtk_loop(12) exprtk_loop(13)
+               exprtk_loop(14) exprtk_loop(15)
 
-               exprtk_disable_fallthrough_begin
-               switch (lud.remainder)
-               {
-                  #define case_stmt(N)                                              \
-                  case N : { vec0[i] = Operation::process(vec0[i], vec1[i]); ++i; } \
+               vec0 += lud.batch_size;
+               vec1 += lud.batch_size;
+            }
 
-                  case_stmt(15) case_stmt(14)
-                  case_stmt(13) case_stmt(12)
-                  case_stmt(11) case_stmt(10)
-                  case_stmt( 9) case_stmt( 8)
-                  case_stmt( 7) case_stmt( 6)
-                  case_stmt( 5) case_stmt( 4)
-                  case_stmt( 3) case_stmt( 2)
-                  case_stmt( 1)
-               }
-               exprtk_disable_fallthrough_end
+            int i = 0;
 
-               #undef exprtk_loop
-               #undef case_stmt
+            exprtk_disable_fallthrough_begin
+            switch (lud.remainder)
+            {
+               #define case_stmt(N)                                              \
+               case N : { vec0[i] = Operation::process(vec0[i], vec1[i]); ++i; } \
 
-               return vec0_node_ptr_->value();
+               case_stmt(15) case_stmt(14)
+               case_stmt(13) case_stmt(12)
+               case_stmt(11) case_stmt(10)
+               case_stmt( 9) case_stmt( 8)
+               case_stmt( 7) case_stmt( 6)
+               case_stmt( 5) case_stmt( 4)
+               case_stmt( 3) case_stmt( 2)
+               case_stmt( 1)
             }
-            else
-               return std::numeric_limits<T>::quiet_NaN();
+            exprtk_disable_fallthrough_end
+
+            #undef exprtk_loop
+            #undef case_stmt
          }
 
          vector_node_ptr vec() const exprtk_override
@@ -5810,6 +6157,7 @@ namespace Essa::Math{
          vector_node<T>* vec1_node_ptr_;
          bool            initialised_;
          vds_t           vds_;
+         kernel_t        kernel_;
       };
 
       template <typename T, typename Operation>
@@ -5823,6 +6171,7 @@ namespace Essa::Math{
          typedef vector_node<T>*     vector_node_ptr;
          typedef vector_holder<T>*   vector_holder_ptr;
          typedef vec_data_store<T>   vds_t;
+         typedef typename vector_kernels<T>::vecvec_t kernel_t;
 
          using binary_node<T>::branch;
 
@@ -5835,7 +6184,11 @@ namespace Essa::Math{
          , temp_         (0)
          , temp_vec_node_(0)
          , initialised_(false)
+         , kernel_     (vector_kernels<T>::vecvec(Operation::operation()))
          {
+            if (0 == kernel_)
+               kernel_ = &scalar_kernel;
+
             bool v0_is_ivec = false;
             bool v1_is_ivec = false;
 
@@ -5910,54 +6263,75 @@ namespace Essa::Math{
                const T* vec1 = vec1_node_ptr_->vds().data();
                      T* vec2 = vds().data();
 
-               loop_unroll::details lud(size());
-               const T* upper_bound = vec2 + lud.upper_bound;
+               vector_kernels<T>::run(kernel_, vec0, vec1, vec2, size());
 
-               while (vec2 < upper_bound)
-               {
-                  #define exprtk_loop(N)                          \
-                  vec2[N] = Operation::process(vec0[N], vec1[N]); \
+               return (vds().data())[0];
+            }
+            else
+               return std::numeric_limits<T>::quiet_NaN();
+         }
 
-                  exprtk_loop( 0) exprtk_loop( 1)
-                  exprtk_loop( 2) exprtk_loop( 3)
-                  exprtk_loop( 4) exprtk_loop( 5)
-                  exprtk_loop( 6) exprtk_loop( 7)
-                  exprtk_loop( 8) exprtk_loop( 9)
-                  exprtk_loop(10) exprtk_loop(11)
-                  exprtk_loop(12) exprtk_loop(13)
-                  exprtk_loop(14) exprtk_loop(15)
+         // The element wise loop for operations without a SIMD kernel.
+         static void scalar_kernel(const T* vec0, const T* vec1, T* vec2, const std::size_t size)
+         {
+            loop_unroll::details lud(size);
+            const T* upper_bound = vec2 + lud.upper_bound;
 
-                  vec0 += lud.batch_size;
-                  vec1 += lud.batch_size;
-                  vec2 += lud.batch_size;
-               }
+            while (vec2 < upper_bound)
+            {
+               #define exprtk_loop(N)                          \
+               vec2[N] = Operation::process(vec0[N], vec1[N]); \
 
-               int i = 0;
+               exprtk_loop( 0) exprtk_loop( 1)
+               exprtk_loop( 2) exprtk_loop( 3)
+               exprtk_loop( 4) exprtk_loop( 5)
+               exprtk_loop( 6) exprtk_loop( 7)
+               exprtk_loop( 8) exprtk_loop( 9)
+               exprtk_loop(10) exprtk_loop(11)
+               exprtk_loop(12) exprtk_loop(13)
+               exprtk_loop(14) exprtk_loop(15)
 
-               exprtk_disable_fallthrough_begin
-               switch (lud.remainder)
-               {
-                  #define case_stmt(N)                                              \
-                  case N : { vec2[i] = Operation::process(vec0[i], vec1[i]); ++i; } \
+               vec0 += lud.batch_size;
+               vec1 += lud.batch_size;
+               vec2 += lud.batch_size;
+            }
 
-                  case_stmt(15) case_stmt(14)
-                  case_stmt(13) case_stmt(12)
-                  case_stmt(11) case_stmt(10)
-                  case_stmt( 9) case_stmt( 8)
-                  case_stmt( 7) case_stmt( 6)
-                  case_stmt( 5) case_stmt( 4)
-                  case_stmt( 3) case_stmt( 2)
-                  case_stmt( 1)
-               }
-               exprtk_disable_fallthrough_end
+            int i = 0;
 
-               #undef exprtk_loop
-               #undef case_stmt
+            exprtk_disable_fallthrough_begin
+            switch (lud.remainder)
+            {
+               #define case_stmt(N)                                              \
+               case N : { vec2[i] = Operation::process(vec0[i], vec1[i]); ++i; } \
 
-               return (vds().data())[0];
+               case_stmt(15) case_stmt(14)
+               case_stmt(13) case_stmt(12)
+               case_stmt(11) case_stmt(10)
+               case_stmt( 9) case_stmt( 8)
+               case_stmt( 7) case_stmt( 6)
+               case_stmt( 5) case_stmt( 4)
+               case_stmt( 3) case_stmt( 2)
+               case_stmt( 1)
             }
-            else
-               return std::numeric_limits<T>::quiet_NaN();
+            exprtk_disable_fallthrough_end
+
+            #undef exprtk_loop
+            #undef case_stmt
+         }
+
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (!initialised_)
+               return false;
+
+            builder.lower(branch(0));
+            builder.lower(branch(1));
+
+            result = builder.vector_vecvec(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process),
+                                           vec0_node_ptr_->vds(),
+                                           vec1_node_ptr_->vds(),
+                                           vds());
+            return true;
          }
 
          vector_node_ptr vec() const exprtk_override
@@ -6000,6 +6374,7 @@ namespace Essa::Math{
          vector_holder_ptr temp_;
          vector_node_ptr   temp_vec_node_;
          bool              initialised_;
+         kernel_t          kernel_;
          vds_t             vds_;
       };
 
@@ -6014,6 +6389,7 @@ namespace Essa::Math{
          typedef vector_node<T>*     vector_node_ptr;
          typedef vector_holder<T>*   vector_holder_ptr;
          typedef vec_data_store<T>   vds_t;
+         typedef typename vector_kernels<T>::vecval_t kernel_t;
 
          using binary_node<T>::branch;
 
@@ -6024,7 +6400,11 @@ namespace Essa::Math{
          , vec0_node_ptr_(0)
          , temp_         (0)
          , temp_vec_node_(0)
+         , kernel_       (vector_kernels<T>::vecval(Operation::operation()))
          {
+            if (0 == kernel_)
+               kernel_ = &scalar_kernel;
+
             bool v0_is_ivec = false;
 
             if (is_vector_node(branch(0)))
@@ -6073,53 +6453,72 @@ namespace Essa::Math{
                const T* vec0 = vec0_node_ptr_->vds().data();
                      T* vec1 = vds().data();
 
-               loop_unroll::details lud(size());
-               const T* upper_bound = vec0 + lud.upper_bound;
+               vector_kernels<T>::run(kernel_, vec0, v, vec1, size());
 
-               while (vec0 < upper_bound)
-               {
-                  #define exprtk_loop(N)                    \
-                  vec1[N] = Operation::process(vec0[N], v); \
+               return (vds().data())[0];
+            }
+            else
+               return std::numeric_limits<T>::quiet_NaN();
+         }
 
-                  exprtk_loop( 0) exprtk_loop( 1)
-                  exprtk_loop( 2) exprtk_loop( 3)
-                  exprtk_loop( 4) exprtk_loop( 5)
-                  exprtk_loop( 6) exprtk_loop( 7)
-                  exprtk_loop( 8) exprtk_loop( 9)
-                  exprtk_loop(10) exprtk_loop(11)
-                  exprtk_loop(12) exprtk_loop(13)
-                  exprtk_loop(14) exprtk_loop(15)
+         static void scalar_kernel(const T* vec0, const T& v, T* vec1, const std::size_t size)
+         {
+            loop_unroll::details lud(size);
+            const T* upper_bound = vec0 + lud.upper_bound;
 
-                  vec0 += lud.batch_size;
-                  vec1 += lud.batch_size;
-               }
+            while (vec0 < upper_bound)
+            {
+               #define exprtk_loop(N)                    \
+               vec1[N] = Operation::process(vec0[N], v); \
 
-               int i = 0;
+               exprtk_loop( 0) exprtk_loop( 1)
+               exprtk_loop( 2) exprtk_loop( 3)
+               exprtk_loop( 4) exprtk_loop( 5)
+               exprtk_loop( 6) exprtk_loop( 7)
+               exprtk_loop( 8) exprtk_loop( 9)
+               exprtk_loop(10) exprtk_loop(11)
+               exprtk_loop(12) exprtk_loop(13)
+               exprtk_loop(14) exprtk_loop(15)
 
-               exprtk_disable_fallthrough_begin
-               switch (lud.remainder)
-               {
-                  #define case_stmt(N)                                        \
-                  case N : { vec1[i] = Operation::process(vec0[i], v); ++i; } \
+               vec0 += lud.batch_size;
+               vec1 += lud.batch_size;
+            }
 
-                  case_stmt(15) case_stmt(14)
-                  case_stmt(13) case_stmt(12)
-                  case_stmt(11) case_stmt(10)
-                  case_stmt( 9) case_stmt( 8)
-                  case_stmt( 7) case_stmt( 6)
-                  case_stmt( 5) case_stmt( 4)
-                  case_stmt( 3) case_stmt( 2)
-                  case_stmt( 1)
-               }
-               exprtk_disable_fallthrough_end
+            int i = 0;
 
-               #undef exprtk_loop
-               #undef case_stmt
+            exprtk_disable_fallthrough_begin
+            switch (lud.remainder)
+            {
+               #define case_stmt(N)                                        \
+               case N : { vec1[i] = Operation::process(vec0[i], v); ++i; } \
 
-               return (vds().data())[0];
+               case_stmt(15) case_stmt(14)
+               case_stmt(13) case_stmt(12)
+               case_stmt(11) case_stmt(10)
+               case_stmt( 9) case_stmt( 8)
+               case_stmt( 7) case_stmt( 6)
+               case_stmt( 5) case_stmt( 4)
+               case_stmt( 3) case_stmt( 2)
+               case_stmt( 1)
             }
-            else
-               return std::numeric_limits<T>::quiet_NaN();
+            exprtk_disable_fallthrough_end
+
+            #undef exprtk_loop
+            #undef case_stmt
+         }
+
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (0 == vec0_node_ptr_)
+               return false;
+
+            const expression_node<T>* branch_list[] = { branch(0), branch(1) };
+            std::size_t operand[2];
+
+            builder.lower(branch_list, operand, 2);
+            result = builder.vector_vecval(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), vec0_node_ptr_->vds(), operand[1], vds());
+
+            return true;
          }
 
          vector_node_ptr vec() const exprtk_override
@@ -6160,6 +6559,7 @@ namespace Essa::Math{
          vector_node_ptr   vec0_node_ptr_;
          vector_holder_ptr temp_;
          vector_node_ptr   temp_vec_node_;
+         kernel_t          kernel_;
          vds_t             vds_;
       };
 
@@ -6174,6 +6574,7 @@ namespace Essa::Math{
          typedef vector_node<T>*     vector_node_ptr;
          typedef vector_holder<T>*   vector_holder_ptr;
          typedef vec_data_store<T>   vds_t;
+         typedef typename vector_kernels<T>::valvec_t kernel_t;
 
          using binary_node<T>::branch;
 
@@ -6184,7 +6585,11 @@ namespace Essa::Math{
          , vec1_node_ptr_(0)
          , temp_         (0)
          , temp_vec_node_(0)
+         , kernel_       (vector_kernels<T>::valvec(Operation::operation()))
          {
+            if (0 == kernel_)
+               kernel_ = &scalar_kernel;
+
             bool v1_is_ivec = false;
 
             if (is_vector_node(branch(1)))
@@ -6233,53 +6638,72 @@ namespace Essa::Math{
                      T* vec0 = vds().data();
                const T* vec1 = vec1_node_ptr_->vds().data();
 
-               loop_unroll::details lud(size());
-               const T* upper_bound = vec0 + lud.upper_bound;
+               vector_kernels<T>::run(kernel_, v, vec1, vec0, size());
 
-               while (vec0 < upper_bound)
-               {
-                  #define exprtk_loop(N)                    \
-                  vec0[N] = Operation::process(v, vec1[N]); \
+               return (vds().data())[0];
+            }
+            else
+               return std::numeric_limits<T>::quiet_NaN();
+         }
 
-                  exprtk_loop( 0) exprtk_loop( 1)
-                  exprtk_loop( 2) exprtk_loop( 3)
-                  exprtk_loop( 4) exprtk_loop( 5)
-                  exprtk_loop( 6) exprtk_loop( 7)
-                  exprtk_loop( 8) exprtk_loop( 9)
-                  exprtk_loop(10) exprtk_loop(11)
-                  exprtk_loop(12) exprtk_loop(13)
-                  exprtk_loop(14) exprtk_loop(15)
+         static void scalar_kernel(const T& v, const T* vec1, T* vec0, const std::size_t size)
+         {
+            loop_unroll::details lud(size);
+            const T* upper_bound = vec0 + lud.upper_bound;
 
-                  vec0 += lud.batch_size;
-                  vec1 += lud.batch_size;
-               }
+            while (vec0 < upper_bound)
+            {
+               #define exprtk_loop(N)                    \
+               vec0[N] = Operation::process(v, vec1[N]); \
 
-               int i = 0;
+               exprtk_loop( 0) exprtk_loop( 1)
+               exprtk_loop( 2) exprtk_loop( 3)
+               exprtk_loop( 4) exprtk_loop( 5)
+               exprtk_loop( 6) exprtk_loop( 7)
+               exprtk_loop( 8) exprtk_loop( 9)
+               exprtk_loop(10) exprtk_loop(11)
+               exprtk_loop(12) exprtk_loop(13)
+               exprtk_loop(14) exprtk_loop(15)
 
-               exprtk_disable_fallthrough_begin
-               switch (lud.remainder)
-               {
-                  #define case_stmt(N)                                        \
-                  case N : { vec0[i] = Operation::process(v, vec1[i]); ++i; } \
+               vec0 += lud.batch_size;
+               vec1 += lud.batch_size;
+            }
 
-                  case_stmt(15) case_stmt(14)
-                  case_stmt(13) case_stmt(12)
-                  case_stmt(11) case_stmt(10)
-                  case_stmt( 9) case_stmt( 8)
-                  case_stmt( 7) case_stmt( 6)
-                  case_stmt( 5) case_stmt( 4)
-                  case_stmt( 3) case_stmt( 2)
-                  case_stmt( 1)
-               }
-               exprtk_disable_fallthrough_end
+            int i = 0;
 
-               #undef exprtk_loop
-               #undef case_stmt
+            exprtk_disable_fallthrough_begin
+            switch (lud.remainder)
+            {
+               #define case_stmt(N)                                        \
+               case N : { vec0[i] = Operation::process(v, vec1[i]); ++i; } \
 
-               return (vds().data())[0];
+               case_stmt(15) case_stmt(14)
+               case_stmt(13) case_stmt(12)
+               case_stmt(11) case_stmt(10)
+               case_stmt( 9) case_stmt( 8)
+               case_stmt( 7) case_stmt( 6)
+               case_stmt( 5) case_stmt( 4)
+               case_stmt( 3) case_stmt( 2)
+               case_stmt( 1)
             }
-            else
-               return std::numeric_limits<T>::quiet_NaN();
+            exprtk_disable_fallthrough_end
+
+            #undef exprtk_loop
+            #undef case_stmt
+         }
+
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (0 == vec1_node_ptr_)
+               return false;
+
+            const expression_node<T>* branch_list[] = { branch(0), branch(1) };
+            std::size_t operand[2];
+
+            builder.lower(branch_list, operand, 2);
+            result = builder.vector_valvec(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), operand[0], vec1_node_ptr_->vds(), vds());
+
+            return true;
          }
 
          vector_node_ptr vec() const exprtk_override
@@ -6320,6 +6744,7 @@ namespace Essa::Math{
          vector_node_ptr   vec1_node_ptr_;
          vector_holder_ptr temp_;
          vector_node_ptr   temp_vec_node_;
+         kernel_t          kernel_;
          vds_t             vds_;
       };
 
@@ -6334,15 +6759,24 @@ namespace Essa::Math{
          typedef vector_node<T>*     vector_node_ptr;
          typedef vector_holder<T>*   vector_holder_ptr;
          typedef vec_data_store<T>   vds_t;
+         typedef typename vector_kernels<T>::unary_t kernel_t;
 
          using expression_node<T>::branch;
 
-         unary_vector_node(const operator_type& opr, expression_ptr branch0)
+         // kernel, when given, replaces the kernels of vector_kernels.
+         unary_vector_node(const operator_type& opr, expression_ptr branch0, kernel_t kernel = 0)
          : unary_node<T>(opr, branch0)
          , vec0_node_ptr_(0)
          , temp_         (0)
          , temp_vec_node_(0)
+         , kernel_       (kernel)
          {
+            if (0 == kernel_)
+               kernel_ = vector_kernels<T>::unary(Operation::operation());
+
+            if (0 == kernel_)
+               kernel_ = &scalar_kernel;
+
             bool vec0_is_ivec = false;
 
             if (is_vector_node(branch()))
@@ -6389,53 +6823,70 @@ namespace Essa::Math{
                const T* vec0 = vec0_node_ptr_->vds().data();
                      T* vec1 = vds().data();
 
-               loop_unroll::details lud(size());
-               const T* upper_bound = vec0 + lud.upper_bound;
+               vector_kernels<T>::run(kernel_, vec0, vec1, size());
 
-               while (vec0 < upper_bound)
-               {
-                  #define exprtk_loop(N)                 \
-                  vec1[N] = Operation::process(vec0[N]); \
+               return (vds().data())[0];
+            }
+            else
+               return std::numeric_limits<T>::quiet_NaN();
+         }
 
-                  exprtk_loop( 0) exprtk_loop( 1)
-                  exprtk_loop( 2) exprtk_loop( 3)
-                  exprtk_loop( 4) exprtk_loop( 5)
-                  exprtk_loop( 6) exprtk_loop( 7)
-                  exprtk_loop( 8) exprtk_loop( 9)
-                  exprtk_loop(10) exprtk_loop(11)
-                  exprtk_loop(12) exprtk_loop(13)
-                  exprtk_loop(14) exprtk_loop(15)
+         static void scalar_kernel(const T* vec0, T* vec1, const std::size_t size)
+         {
+            loop_unroll::details lud(size);
+            const T* upper_bound = vec0 + lud.upper_bound;
 
-                  vec0 += lud.batch_size;
-                  vec1 += lud.batch_size;
-               }
+            while (vec0 < upper_bound)
+            {
+               #define exprtk_loop(N)                 \
+               vec1[N] = Operation::process(vec0[N]); \
 
-               int i = 0;
+               exprtk_loop( 0) exprtk_loop( 1)
+               exprtk_loop( 2) exprtk_loop( 3)
+               exprtk_loop( 4) exprtk_loop( 5)
+               exprtk_loop( 6) exprtk_loop( 7)
+               exprtk_loop( 8) exprtk_loop( 9)
+               exprtk_loop(10) exprtk_loop(11)
+               exprtk_loop(12) exprtk_loop(13)
+               exprtk_loop(14) exprtk_loop(15)
 
-               exprtk_disable_fallthrough_begin
-               switch (lud.remainder)
-               {
-                  #define case_stmt(N)                                     \
-                  case N : { vec1[i] = Operation::process(vec0[i]); ++i; } \
+               vec0 += lud.batch_size;
+               vec1 += lud.batch_size;
+            }
 
-                  case_stmt(15) case_stmt(14)
-                  case_stmt(13) case_stmt(12)
-                  case_stmt(11) case_stmt(10)
-                  case_stmt( 9) case_stmt( 8)
-                  case_stmt( 7) case_stmt( 6)
-                  case_stmt( 5) case_stmt( 4)
-                  case_stmt( 3) case_stmt( 2)
-                  case_stmt( 1)
-               }
-               exprtk_disable_fallthrough_end
+            int i = 0;
 
-               #undef exprtk_loop
-               #undef case_stmt
+            exprtk_disable_fallthrough_begin
+            switch (lud.remainder)
+            {
+               #define case_stmt(N)                                     \
+               case N : { vec1[i] = Operation::process(vec0[i]); ++i; } \
 
-               return (vds().data())[0];
+               case_stmt(15) case_stmt(14)
+               case_stmt(13) case_stmt(12)
+               case_stmt(11) case_stmt(10)
+               case_stmt( 9) case_stmt( 8)
+               case_stmt( 7) case_stmt( 6)
+               case_stmt( 5) case_stmt( 4)
+               case_stmt( 3) case_stmt( 2)
+               case_stmt( 1)
             }
-            else
-               return std::numeric_limits<T>::quiet_NaN();
+            exprtk_disable_fallthrough_end
+
+            #undef exprtk_loop
+            #undef case_stmt
+         }
+
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (0 == vec0_node_ptr_)
+               return false;
+
+            builder.lower(branch());
+
+            result = builder.vector_unary(&Operation::process, vec0_node_ptr_->vds(), vds(), kernel_);
+
+            return true;
          }
 
          vector_node_ptr vec() const exprtk_override
@@ -6476,6 +6927,7 @@ namespace Essa::Math{
          vector_node_ptr   vec0_node_ptr_;
          vector_holder_ptr temp_;
          vector_node_ptr   temp_vec_node_;
+         kernel_t          kernel_;
          vds_t             vds_;
       };
 
@@ -6787,6 +7239,37 @@ namespace Essa::Math{
             return expression_node<T>::ndb_t::template compute_node_depth<N>(branch_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (0 == function_)
+               return false;
+
+            const expression_node<T>* b[N];
+            std::size_t operand[N];
+
+            for (std::size_t i = 0; i < N; ++i)
+            {
+               b[i] = branch_[i].first;
+            }
+
+            builder.lower(b, operand, N);
+
+            result = builder.function(function_, &invoke_arguments, operand, N);
+            return true;
+         }
+
+         static inline T invoke_arguments(ifunction& f, const T* const* argument)
+         {
+            T v[N];
+
+            for (std::size_t i = 0; i < N; ++i)
+            {
+               v[i] = *argument[i];
+            }
+
+            return invoke<T,N>::execute(f,v);
+         }
+
          template <typename T_, std::size_t BranchCount>
          struct evaluate_branches
          {
@@ -7032,6 +7515,20 @@ namespace Essa::Math{
                return std::numeric_limits<T>::quiet_NaN();
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            if (0 == function_)
+               return false;
+
+            result = builder.function(function_, &invoke_arguments, 0, 0);
+            return true;
+         }
+
+         static inline T invoke_arguments(ifunction& f, const T* const*)
+         {
+            return f();
+         }
+
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
             return expression_node<T>::e_function;
@@ -7482,154 +7979,413 @@ namespace Essa::Math{
                   str_function_t::range_.n1_c.second  = str_function_t::ret_string_.size() - 1;
                   str_function_t::range_.cache.second = str_function_t::range_.n1_c.second;
 
-                  return result;
-               }
+                  return result;
+               }
+            }
+
+            return std::numeric_limits<T>::quiet_NaN();
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_strfunction;
+         }
+
+         inline std::string to_string() const exprtk_override{
+            return "(multimode_strfunction_node)";
+         }
+      private:
+
+         const std::size_t param_seq_index_;
+      };
+
+      class return_exception
+      {};
+
+      template <typename T>
+      class null_igenfunc
+      {
+      public:
+
+         virtual ~null_igenfunc() {}
+
+         typedef type_store<T> generic_type;
+         typedef typename generic_type::parameter_list parameter_list_t;
+
+         inline virtual T operator() (parameter_list_t)
+         {
+            return std::numeric_limits<T>::quiet_NaN();
+         }
+      };
+
+      template <typename T>
+      class return_node exprtk_final : public generic_function_node<T,null_igenfunc<T> >
+      {
+      public:
+
+         typedef results_context<T>   results_context_t;
+         typedef null_igenfunc<T>     igeneric_function_t;
+         typedef igeneric_function_t* igeneric_function_ptr;
+         typedef generic_function_node<T,igeneric_function_t> gen_function_t;
+
+         return_node(const std::vector<typename gen_function_t::expression_ptr>& arg_list,
+                     results_context_t& rc)
+         : gen_function_t  (arg_list)
+         , results_context_(&rc)
+         {}
+
+         inline T value() const exprtk_override
+         {
+            if (
+                 (0 != results_context_) &&
+                 gen_function_t::populate_value_list()
+               )
+            {
+               typedef typename type_store<T>::parameter_list parameter_list_t;
+
+               results_context_->
+                  assign(parameter_list_t(gen_function_t::typestore_list_));
+
+               throw return_exception();
+            }
+
+            return std::numeric_limits<T>::quiet_NaN();
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_return;
+         }
+
+         inline std::string to_string() const exprtk_override{
+            return "(return_node)";
+         }
+      private:
+
+         results_context_t* results_context_;
+      };
+
+      template <typename T>
+      class return_envelope_node exprtk_final : public expression_node<T>
+      {
+      public:
+
+         typedef expression_node<T>* expression_ptr;
+         typedef results_context<T>  results_context_t;
+         typedef std::pair<expression_ptr,bool> branch_t;
+
+         return_envelope_node(expression_ptr body, results_context_t& rc)
+         : results_context_(&rc  )
+         , return_invoked_ (false)
+         {
+            construct_branch_pair(body_, body);
+         }
+
+         inline T value() const exprtk_override
+         {
+            assert(body_.first);
+
+            try
+            {
+               return_invoked_ = false;
+               results_context_->clear();
+
+               return body_.first->value();
+            }
+            catch(const return_exception&)
+            {
+               return_invoked_ = true;
+               return std::numeric_limits<T>::quiet_NaN();
+            }
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
+         {
+            return expression_node<T>::e_retenv;
+         }
+
+         inline bool* retinvk_ptr()
+         {
+            return &return_invoked_;
+         }
+
+         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
+         {
+            expression_node<T>::ndb_t::collect(body_, node_delete_list);
+         }
+
+         std::size_t node_depth() const exprtk_override
+         {
+            return expression_node<T>::ndb_t::compute_node_depth(body_);
+         }
+
+         inline std::string to_string() const exprtk_override{
+            return "(return_envelope_node)";
+         }
+      private:
+
+         results_context_t* results_context_;
+         mutable bool        return_invoked_;
+         branch_t                      body_;
+      };
+
+      // A subtree occurring more than once in an expression, kept by the
+      // shared_expression_node at the root. It is evaluated by the first
+      // occurrence reached while pending is set and its value reused by the
+      // others.
+      template <typename T>
+      struct shared_subexpression
+      {
+         typedef expression_node<T>* expression_ptr;
+         typedef std::pair<expression_ptr,bool> branch_t;
+
+         branch_t  branch;
+         mutable T value;
+         mutable T pending;
+      };
+
+      template <typename T>
+      class shared_reference_node exprtk_final : public expression_node<T>
+      {
+      public:
+
+         typedef shared_subexpression<T> subexpression_t;
+
+         explicit shared_reference_node(const subexpression_t& subexpression)
+         : subexpression_(&subexpression)
+         {}
+
+         inline T value() const exprtk_override
+         {
+            if (is_true(subexpression_->pending))
+            {
+               subexpression_->value   = subexpression_->branch.first->value();
+               subexpression_->pending = T(0);
             }
 
-            return std::numeric_limits<T>::quiet_NaN();
+            return subexpression_->value;
          }
 
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
-            return expression_node<T>::e_strfunction;
+            return expression_node<T>::e_sharedref;
+         }
+
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            // Programs without jumps evaluate every occurrence, programs
+            // sharing values compute it once per stretch of straight code.
+            if (builder.branch_free() || builder.shares_values())
+            {
+               result = builder.lower(subexpression_->branch.first);
+               return true;
+            }
+
+            const std::size_t pending  = builder.reference(subexpression_->pending);
+            const std::size_t jump_end = builder.jump_false(pending);
+            builder.move(builder.reference(subexpression_->value), builder.lower(subexpression_->branch.first));
+            builder.move(pending, builder.constant(T(0)));
+            builder.patch(jump_end, builder.position());
+
+            result = builder.reference(subexpression_->value);
+
+            return true;
          }
 
          inline std::string to_string() const exprtk_override{
-            return "(multimode_strfunction_node)";
+            return subexpression_->branch.first->to_string();
          }
       private:
 
-         const std::size_t param_seq_index_;
+         const subexpression_t* subexpression_;
       };
 
-      class return_exception
-      {};
-
       template <typename T>
-      class null_igenfunc
+      class shared_expression_node exprtk_final : public expression_node<T>
       {
       public:
 
-         virtual ~null_igenfunc() {}
+         typedef expression_node<T>* expression_ptr;
+         typedef std::pair<expression_ptr,bool> branch_t;
+         typedef shared_subexpression<T> subexpression_t;
 
-         typedef type_store<T> generic_type;
-         typedef typename generic_type::parameter_list parameter_list_t;
+         shared_expression_node()
+         : branch_(expression_ptr(0), false)
+         {}
 
-         inline virtual T operator() (parameter_list_t)
+         // Takes ownership of the subtree, the returned reference stays
+         // valid for the lifetime of the node.
+         const subexpression_t& share(expression_ptr branch)
          {
-            return std::numeric_limits<T>::quiet_NaN();
+            subexpression_list_.push_back(subexpression_t());
+            construct_branch_pair(subexpression_list_.back().branch, branch);
+            subexpression_list_.back().value   = T(0);
+            subexpression_list_.back().pending = T(1);
+
+            return subexpression_list_.back();
          }
-      };
 
-      template <typename T>
-      class return_node exprtk_final : public generic_function_node<T,null_igenfunc<T> >
-      {
-      public:
+         void set_branch(expression_ptr branch)
+         {
+            construct_branch_pair(branch_, branch);
+         }
 
-         typedef results_context<T>   results_context_t;
-         typedef null_igenfunc<T>     igeneric_function_t;
-         typedef igeneric_function_t* igeneric_function_ptr;
-         typedef generic_function_node<T,igeneric_function_t> gen_function_t;
+         inline T value() const exprtk_override
+         {
+            assert(branch_.first);
 
-         return_node(const std::vector<typename gen_function_t::expression_ptr>& arg_list,
-                     results_context_t& rc)
-         : gen_function_t  (arg_list)
-         , results_context_(&rc)
-         {}
+            for (std::size_t i = 0; i < subexpression_list_.size(); ++i)
+            {
+               subexpression_list_[i].pending = T(1);
+            }
 
-         inline T value() const exprtk_override
+            return branch_.first->value();
+         }
+
+         inline typename expression_node<T>::node_type type() const exprtk_override
          {
-            if (
-                 (0 != results_context_) &&
-                 gen_function_t::populate_value_list()
-               )
+            return expression_node<T>::e_sharedexpr;
+         }
+
+         inline expression_node<T>* branch(const std::size_t&) const exprtk_override
+         {
+            return branch_.first;
+         }
+
+         void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
+         {
+            expression_node<T>::ndb_t::collect(branch_, node_delete_list);
+
+            for (std::size_t i = 0; i < subexpression_list_.size(); ++i)
             {
-               typedef typename type_store<T>::parameter_list parameter_list_t;
+               expression_node<T>::ndb_t::collect(subexpression_list_[i].branch, node_delete_list);
+            }
+         }
 
-               results_context_->
-                  assign(parameter_list_t(gen_function_t::typestore_list_));
+         std::size_t node_depth() const exprtk_override
+         {
+            if (!expression_node<T>::ndb_t::depth_set)
+            {
+               std::size_t depth = branch_.first ? branch_.first->node_depth() : 0;
 
-               throw return_exception();
+               for (std::size_t i = 0; i < subexpression_list_.size(); ++i)
+               {
+                  depth = std::max(depth, subexpression_list_[i].branch.first->node_depth());
+               }
+
+               expression_node<T>::ndb_t::depth     = depth + 1;
+               expression_node<T>::ndb_t::depth_set = true;
             }
 
-            return std::numeric_limits<T>::quiet_NaN();
+            return expression_node<T>::ndb_t::depth;
          }
 
-         inline typename expression_node<T>::node_type type() const exprtk_override
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
          {
-            return expression_node<T>::e_return;
+            if (!builder.branch_free() && !builder.shares_values())
+            {
+               for (std::size_t i = 0; i < subexpression_list_.size(); ++i)
+               {
+                  builder.move(builder.reference(subexpression_list_[i].pending), builder.constant(T(1)));
+               }
+            }
+
+            result = builder.lower(branch_.first);
+
+            return true;
          }
 
          inline std::string to_string() const exprtk_override{
-            return "(return_node)";
+            return branch_.first->to_string();
          }
       private:
 
-         results_context_t* results_context_;
+         branch_t                    branch_;
+         std::deque<subexpression_t> subexpression_list_;
       };
 
+      // Keeps the value of a subtree free of side effects for as long as
+      // the memory it reads holds the same bytes. Only tree evaluation is
+      // memoised, lowering yields the subtree itself.
       template <typename T>
-      class return_envelope_node exprtk_final : public expression_node<T>
+      class memo_node exprtk_final : public expression_node<T>
       {
       public:
 
          typedef expression_node<T>* expression_ptr;
-         typedef results_context<T>  results_context_t;
          typedef std::pair<expression_ptr,bool> branch_t;
 
-         return_envelope_node(expression_ptr body, results_context_t& rc)
-         : results_context_(&rc  )
-         , return_invoked_ (false)
+         memo_node(expression_ptr branch, const std::vector<const T*>& read_list)
+         : read_list_(read_list)
+         , snapshot_ (read_list.size())
+         , value_    (T(0))
+         , valid_    (false)
          {
-            construct_branch_pair(body_, body);
+            construct_branch_pair(branch_, branch);
          }
 
          inline T value() const exprtk_override
          {
-            assert(body_.first);
+            assert(branch_.first);
 
-            try
-            {
-               return_invoked_ = false;
-               results_context_->clear();
+            bool valid = valid_;
 
-               return body_.first->value();
+            for (std::size_t i = 0; valid && (i < read_list_.size()); ++i)
+            {
+               valid = (0 == std::memcmp(&snapshot_[i], read_list_[i], sizeof(T)));
             }
-            catch(const return_exception&)
+
+            if (!valid)
             {
-               return_invoked_ = true;
-               return std::numeric_limits<T>::quiet_NaN();
+               for (std::size_t i = 0; i < read_list_.size(); ++i)
+               {
+                  std::memcpy(&snapshot_[i], read_list_[i], sizeof(T));
+               }
+
+               value_ = branch_.first->value();
+               valid_ = true;
             }
+
+            return value_;
          }
 
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
-            return expression_node<T>::e_retenv;
+            return expression_node<T>::e_memo;
          }
 
-         inline bool* retinvk_ptr()
+         inline expression_node<T>* branch(const std::size_t&) const exprtk_override
          {
-            return &return_invoked_;
+            return branch_.first;
          }
 
          void collect_nodes(typename expression_node<T>::noderef_list_t& node_delete_list) exprtk_override
          {
-            expression_node<T>::ndb_t::collect(body_, node_delete_list);
+            expression_node<T>::ndb_t::collect(branch_, node_delete_list);
          }
 
          std::size_t node_depth() const exprtk_override
          {
-            return expression_node<T>::ndb_t::compute_node_depth(body_);
+            return expression_node<T>::ndb_t::compute_node_depth(branch_);
+         }
+
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.lower(branch_.first);
+
+            return true;
          }
 
          inline std::string to_string() const exprtk_override{
-            return "(return_envelope_node)";
+            return branch_.first->to_string();
          }
       private:
 
-         results_context_t* results_context_;
-         mutable bool        return_invoked_;
-         branch_t                      body_;
+         branch_t                branch_;
+         std::vector<const T*>   read_list_;
+         mutable std::vector<T>  snapshot_;
+         mutable T               value_;
+         mutable bool            valid_;
       };
 
       #define exprtk_define_unary_op(OpName)                    \
@@ -7859,6 +8615,12 @@ namespace Essa::Math{
          inline std::string to_string() const exprtk_override{
             return "(unary_variable_node)";
          }
+
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.unary(&Operation::process, builder.reference(v_));
+            return true;
+         }
       private:
 
          unary_variable_node(const unary_variable_node<T,Operation>&) exprtk_delete;
@@ -7922,6 +8684,14 @@ namespace Essa::Math{
             return f_;
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const std::size_t u0 = builder.unary(u0_, builder.reference(v0_));
+            const std::size_t u1 = builder.unary(u1_, builder.reference(v1_));
+            result = builder.binary(f_, u0, u1);
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             return "(uvouv_node)";
          }
@@ -7986,6 +8756,12 @@ namespace Essa::Math{
             return expression_node<T>::ndb_t::compute_node_depth(branch_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.unary(&Operation::process, builder.lower(branch_.first));
+            return true;
+         }
+
          inline std::string to_string() const exprtk_override{
             char _buf[2048]{0};
             std::string _name = to_str(operation());
@@ -8003,6 +8779,15 @@ namespace Essa::Math{
             #define exprtk_crtype(Type)                          \
       param_to_str<is_const_ref< Type >::result>::result() \
 
+      template <typename T, typename Operand>
+      inline std::size_t lower_operand(bytecode_builder<T>& builder, const T& operand)
+      {
+         if (is_const_ref<Operand>::result)
+            return builder.reference(operand);
+         else
+            return builder.constant(operand);
+      }
+
       template <typename T>
       struct T0oT1oT2process
       {
@@ -8017,6 +8802,13 @@ namespace Essa::Math{
                return bf1(bf0(t0,t1),t2);
             }
 
+            static inline std::size_t lower(bytecode_builder<T>& builder,
+                                            const std::size_t t0, const std::size_t t1, const std::size_t t2,
+                                            const bfunc_t bf0, const bfunc_t bf1)
+            {
+               return builder.binary(bf1, builder.binary(bf0, t0, t1), t2);
+            }
+
             template <typename T0, typename T1, typename T2>
             static inline std::string id()
             {
@@ -8035,6 +8827,13 @@ namespace Essa::Math{
                return bf0(t0,bf1(t1,t2));
             }
 
+            static inline std::size_t lower(bytecode_builder<T>& builder,
+                                            const std::size_t t0, const std::size_t t1, const std::size_t t2,
+                                            const bfunc_t bf0, const bfunc_t bf1)
+            {
+               return builder.binary(bf0, t0, builder.binary(bf1, t1, t2));
+            }
+
             template <typename T0, typename T1, typename T2>
             static inline std::string id()
             {
@@ -8062,6 +8861,14 @@ namespace Essa::Math{
                return bf1(bf0(t0,t1),bf2(t2,t3));
             }
 
+            static inline std::size_t lower(bytecode_builder<T>& builder,
+                                            const std::size_t t0, const std::size_t t1,
+                                            const std::size_t t2, const std::size_t t3,
+                                            const bfunc_t bf0, const bfunc_t bf1, const bfunc_t bf2)
+            {
+               return builder.binary(bf1, builder.binary(bf0, t0, t1), builder.binary(bf2, t2, t3));
+            }
+
             template <typename T0, typename T1, typename T2, typename T3>
             static inline std::string id()
             {
@@ -8082,6 +8889,14 @@ namespace Essa::Math{
                // (T0 o0 (T1 o1 (T2 o2 T3))
                return bf0(t0,bf1(t1,bf2(t2,t3)));
             }
+
+            static inline std::size_t lower(bytecode_builder<T>& builder,
+                                            const std::size_t t0, const std::size_t t1,
+                                            const std::size_t t2, const std::size_t t3,
+                                            const bfunc_t bf0, const bfunc_t bf1, const bfunc_t bf2)
+            {
+               return builder.binary(bf0, t0, builder.binary(bf1, t1, builder.binary(bf2, t2, t3)));
+            }
             template <typename T0, typename T1, typename T2, typename T3>
             static inline std::string id()
             {
@@ -8103,6 +8918,14 @@ namespace Essa::Math{
                return bf0(t0,bf2(bf1(t1,t2),t3));
             }
 
+            static inline std::size_t lower(bytecode_builder<T>& builder,
+                                            const std::size_t t0, const std::size_t t1,
+                                            const std::size_t t2, const std::size_t t3,
+                                            const bfunc_t bf0, const bfunc_t bf1, const bfunc_t bf2)
+            {
+               return builder.binary(bf0, t0, builder.binary(bf2, builder.binary(bf1, t1, t2), t3));
+            }
+
             template <typename T0, typename T1, typename T2, typename T3>
             static inline std::string id()
             {
@@ -8124,6 +8947,14 @@ namespace Essa::Math{
                return bf2(bf1(bf0(t0,t1),t2),t3);
             }
 
+            static inline std::size_t lower(bytecode_builder<T>& builder,
+                                            const std::size_t t0, const std::size_t t1,
+                                            const std::size_t t2, const std::size_t t3,
+                                            const bfunc_t bf0, const bfunc_t bf1, const bfunc_t bf2)
+            {
+               return builder.binary(bf2, builder.binary(bf1, builder.binary(bf0, t0, t1), t2), t3);
+            }
+
             template <typename T0, typename T1, typename T2, typename T3>
             static inline std::string id()
             {
@@ -8145,6 +8976,14 @@ namespace Essa::Math{
                return bf2(bf0(t0,bf1(t1,t2)),t3);
             }
 
+            static inline std::size_t lower(bytecode_builder<T>& builder,
+                                            const std::size_t t0, const std::size_t t1,
+                                            const std::size_t t2, const std::size_t t3,
+                                            const bfunc_t bf0, const bfunc_t bf1, const bfunc_t bf2)
+            {
+               return builder.binary(bf2, builder.binary(bf0, t0, builder.binary(bf1, t1, t2)), t3);
+            }
+
             template <typename T0, typename T1, typename T2, typename T3>
             static inline std::string id()
             {
@@ -8264,6 +9103,14 @@ namespace Essa::Math{
             return f_(t0_,t1_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.binary(f_,
+                                    lower_operand<T,T0>(builder, t0_),
+                                    lower_operand<T,T1>(builder, t1_));
+            return true;
+         }
+
          inline T0 t0() const
          {
             return t0_;
@@ -8337,6 +9184,16 @@ namespace Essa::Math{
             return ProcessMode::process(t0_, t1_, t2_, f0_, f1_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = ProcessMode::lower(builder,
+                                        lower_operand<T,T0>(builder, t0_),
+                                        lower_operand<T,T1>(builder, t1_),
+                                        lower_operand<T,T2>(builder, t2_),
+                                        f0_, f1_);
+            return true;
+         }
+
          inline T0 t0() const
          {
             return t0_;
@@ -8425,6 +9282,17 @@ namespace Essa::Math{
             return ProcessMode::process(t0_, t1_, t2_, t3_, f0_, f1_, f2_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = ProcessMode::lower(builder,
+                                        lower_operand<T,T0>(builder, t0_),
+                                        lower_operand<T,T1>(builder, t1_),
+                                        lower_operand<T,T2>(builder, t2_),
+                                        lower_operand<T,T3>(builder, t3_),
+                                        f0_, f1_, f2_);
+            return true;
+         }
+
          inline T0 t0() const
          {
             return t0_;
@@ -8530,6 +9398,15 @@ namespace Essa::Math{
             return f_(t0_, t1_, t2_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.trinary(f_,
+                                     lower_operand<T,T0>(builder, t0_),
+                                     lower_operand<T,T1>(builder, t1_),
+                                     lower_operand<T,T2>(builder, t2_));
+            return true;
+         }
+
          inline T0 t0() const
          {
             return t0_;
@@ -8626,6 +9503,15 @@ namespace Essa::Math{
             return SF3Operation::process(t0_, t1_, t2_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.trinary(&SF3Operation::process,
+                                     lower_operand<T,T0>(builder, t0_),
+                                     lower_operand<T,T1>(builder, t1_),
+                                     lower_operand<T,T2>(builder, t2_));
+            return true;
+         }
+
          T0 t0() const exprtk_override
          {
             return t0_;
@@ -8720,6 +9606,16 @@ namespace Essa::Math{
             return f_(t0_, t1_, t2_, t3_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.quaternary(f_,
+                                        lower_operand<T,T0>(builder, t0_),
+                                        lower_operand<T,T1>(builder, t1_),
+                                        lower_operand<T,T2>(builder, t2_),
+                                        lower_operand<T,T3>(builder, t3_));
+            return true;
+         }
+
          inline T0 t0() const
          {
             return t0_;
@@ -8804,6 +9700,16 @@ namespace Essa::Math{
             return SF4Operation::process(t0_, t1_, t2_, t3_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.quaternary(&SF4Operation::process,
+                                        lower_operand<T,T0>(builder, t0_),
+                                        lower_operand<T,T1>(builder, t1_),
+                                        lower_operand<T,T2>(builder, t2_),
+                                        lower_operand<T,T3>(builder, t3_));
+            return true;
+         }
+
          inline T0 t0() const
          {
             return t0_;
@@ -8919,6 +9825,14 @@ namespace Essa::Math{
             return Operation::process(v0_,v1_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const std::size_t a = builder.reference(v0_);
+            const std::size_t b = builder.reference(v1_);
+            result = builder.binary(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), a, b);
+            return true;
+         }
+
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
             return Operation::type();
@@ -8972,6 +9886,14 @@ namespace Essa::Math{
             return Operation::process(c_,v_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const std::size_t a = builder.constant (c_ );
+            const std::size_t b = builder.reference(v_ );
+            result = builder.binary(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), a, b);
+            return true;
+         }
+
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
             return Operation::type();
@@ -9025,6 +9947,14 @@ namespace Essa::Math{
             return Operation::process(v_,c_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const std::size_t a = builder.reference(v_ );
+            const std::size_t b = builder.constant (c_ );
+            result = builder.binary(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), a, b);
+            return true;
+         }
+
          inline operator_type operation() const exprtk_override
          {
             return Operation::operation();
@@ -9076,6 +10006,14 @@ namespace Essa::Math{
             return Operation::process(v_,branch_.first->value());
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const std::size_t a = builder.reference(v_);
+            const std::size_t b = builder.lower(branch_.first);
+            result = builder.binary(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), a, b);
+            return true;
+         }
+
          inline const T& v() const exprtk_override
          {
             return v_;
@@ -9130,6 +10068,14 @@ namespace Essa::Math{
             return Operation::process(branch_.first->value(),v_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const std::size_t a = builder.lower(branch_.first);
+            const std::size_t b = builder.reference(v_);
+            result = builder.binary(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), a, b);
+            return true;
+         }
+
          inline const T& v() const exprtk_override
          {
             return v_;
@@ -9184,6 +10130,14 @@ namespace Essa::Math{
             return Operation::process(c_,branch_.first->value());
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const std::size_t a = builder.constant(c_);
+            const std::size_t b = builder.lower(branch_.first);
+            result = builder.binary(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), a, b);
+            return true;
+         }
+
          inline operator_type operation() const exprtk_override
          {
             return Operation::operation();
@@ -9254,6 +10208,14 @@ namespace Essa::Math{
             return Operation::process(branch_.first->value(),c_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            const std::size_t a = builder.lower(branch_.first);
+            const std::size_t b = builder.constant(c_);
+            result = builder.binary(static_cast<typename functor_t<T>::bfunc_t>(&Operation::process), a, b);
+            return true;
+         }
+
          inline operator_type operation() const exprtk_override
          {
             return Operation::operation();
@@ -9739,6 +10701,20 @@ namespace Essa::Math{
          node_type& operator=(const node_type&) exprtk_delete;
       };
 
+      template <typename T, typename PowOp>
+      struct ipow_function
+      {
+         static inline T process(const T& v)
+         {
+            return PowOp::result(v);
+         }
+
+         static inline T inverse(const T& v)
+         {
+            return (T(1) / PowOp::result(v));
+         }
+      };
+
       template <typename T, typename PowOp>
       class ipow_node exprtk_final: public expression_node<T>
       {
@@ -9756,6 +10732,12 @@ namespace Essa::Math{
             return PowOp::result(v_);
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.unary(&ipow_function<T,PowOp>::process, builder.reference(v_));
+            return true;
+         }
+
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
             return expression_node<T>::e_ipow;
@@ -9792,6 +10774,12 @@ namespace Essa::Math{
             return PowOp::result(branch_.first->value());
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.unary(&ipow_function<T,PowOp>::process, builder.lower(branch_.first));
+            return true;
+         }
+
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
             return expression_node<T>::e_ipow;
@@ -9835,6 +10823,12 @@ namespace Essa::Math{
             return (T(1) / PowOp::result(v_));
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.unary(&ipow_function<T,PowOp>::inverse, builder.reference(v_));
+            return true;
+         }
+
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
             return expression_node<T>::e_ipowinv;
@@ -9871,6 +10865,12 @@ namespace Essa::Math{
             return (T(1) / PowOp::result(branch_.first->value()));
          }
 
+         inline bool lower(bytecode_builder<T>& builder, std::size_t& result) const exprtk_override
+         {
+            result = builder.unary(&ipow_function<T,PowOp>::inverse, builder.lower(branch_.first));
+            return true;
+         }
+
          inline typename expression_node<T>::node_type type() const exprtk_override
          {
             return expression_node<T>::e_ipowinv;
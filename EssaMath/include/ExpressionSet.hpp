@@ -0,0 +1,136 @@
+#pragma once
+
+#include "include/Bytecode.hpp"
+#include "include/Expression.hpp"
+#include <vector>
+
+namespace Essa::Math{
+   // Evaluates a set of expressions, in the order they were added, with
+   // one run of a single bytecode program. The program is built by a
+   // builder sharing values, so a term occurring in several expressions
+   // is computed once as long as nothing written in between changes it.
+   // The set keeps the expressions alive, and shares the evaluation
+   // restrictions of bytecode_program.
+   template <typename T>
+   class expression_set
+   {
+   public:
+
+      typedef expression<T> expression_t;
+
+      expression_set()
+      : program_(0)
+      {}
+
+     ~expression_set()
+      {
+         clear_program();
+      }
+
+      // Returns the index of the expression's value in value_list().
+      std::size_t add(const expression_t& e)
+      {
+         clear_program();
+         expression_list_.push_back(e);
+
+         return expression_list_.size() - 1;
+      }
+
+      std::size_t size() const
+      {
+         return expression_list_.size();
+      }
+
+      void clear()
+      {
+         clear_program();
+         expression_list_.clear();
+         value_list_.clear();
+      }
+
+      // Builds the program, which evaluate() otherwise does on first use.
+      bool compile()
+      {
+         clear_program();
+
+         if (expression_list_.empty())
+            return false;
+
+         std::vector<const details::expression_node<T>*> root_list(expression_list_.size());
+
+         for (std::size_t i = 0; i < expression_list_.size(); ++i)
+         {
+            if ((0 == expression_list_[i].control_block_) || (0 == expression_list_[i].control_block_->expr))
+               return false;
+
+            root_list[i] = expression_list_[i].control_block_->expr;
+         }
+
+         value_list_.assign(expression_list_.size(), T(0));
+
+         details::bytecode_program<T>* program = new details::bytecode_program<T>();
+         details::bytecode_builder<T> builder(*program, false, true);
+
+         if (!builder.build(&root_list[0], &value_list_[0], root_list.size()))
+         {
+            delete program;
+            return false;
+         }
+
+         program_ = program;
+
+         return true;
+      }
+
+      const std::vector<T>& evaluate()
+      {
+         if (program_ || compile())
+            program_->value();
+         else
+         {
+            value_list_.resize(expression_list_.size());
+
+            for (std::size_t i = 0; i < expression_list_.size(); ++i)
+            {
+               value_list_[i] = expression_list_[i].value();
+            }
+         }
+
+         return value_list_;
+      }
+
+      // Values from the last evaluate().
+      const std::vector<T>& value_list() const
+      {
+         return value_list_;
+      }
+
+      const T& value(const std::size_t index) const
+      {
+         return value_list_[index];
+      }
+
+      const details::bytecode_program<T>* bytecode() const
+      {
+         return program_;
+      }
+
+   private:
+
+      expression_set(const expression_set<T>&) exprtk_delete;
+      expression_set<T>& operator=(const expression_set<T>&) exprtk_delete;
+
+      void clear_program()
+      {
+         if (program_)
+         {
+            delete program_;
+            program_ = 0;
+         }
+      }
+
+      std::vector<expression_t>     expression_list_;
+      std::vector<T>                value_list_;
+      details::bytecode_program<T>* program_;
+   };
+}
@@ -37,6 +37,11 @@
 
 namespace Essa::Math{
    namespace lexer{
+      namespace helper
+      {
+         class assembly_pipeline;
+      }
+
       class generator
       {
       public:
@@ -102,6 +107,7 @@ namespace Essa::Math{
 
       private:
 
+         std::string        source_;
          token_list_t       token_list_;
          token_list_itr_t   token_itr_;
          token_list_itr_t   store_token_itr_;
@@ -114,6 +120,7 @@ namespace Essa::Math{
          friend class token_modifier;
          friend class token_inserter;
          friend class token_joiner;
+         friend class helper::assembly_pipeline;
       }; // class generator
    }
 }
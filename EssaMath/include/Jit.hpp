@@ -0,0 +1,84 @@
+#pragma once
+
+#include "include/Bytecode.hpp"
+#include <vector>
+
+namespace Essa::Math{
+   namespace details
+   {
+      // Native x86-64 code translated from a bytecode program. Arithmetic,
+      // negation, conditionals and jumps become SSE2 instructions, function
+      // calls become direct calls, and everything else, including subtrees
+      // the bytecode hands back to the tree walker, calls out through
+      // bytecode_program::execute(). The code reads and writes the same
+      // memory as the program, which has to outlive it. Only double is
+      // translated, on x86-64 targets using the System V calling convention.
+      template <typename T>
+      class jit_program
+      {
+      public:
+
+         typedef bytecode_program<T>              program_t;
+         typedef typename program_t::instruction instruction_t;
+
+         jit_program();
+
+        ~jit_program();
+
+         // Returns false, leaving the object empty, when the target or T is
+         // not supported or executable memory cannot be obtained.
+         bool compile(const program_t& program);
+
+         T value() const;
+
+         bool valid() const;
+
+         std::size_t code_size() const;
+
+         static bool supported();
+
+      private:
+
+         typedef T (*function_t)();
+
+         struct jump_fixup
+         {
+            std::size_t offset;
+            std::size_t target;
+         };
+
+         jit_program(const jit_program<T>&) exprtk_delete;
+         jit_program<T>& operator=(const jit_program<T>&) exprtk_delete;
+
+         void release();
+
+         void emit(const unsigned char byte);
+
+         void emit_u32(const uint32_t value);
+
+         void emit_u64(const uint64_t value);
+
+         // Emits an SSE2 instruction whose r/m operand is the double at
+         // address, addressed relative to the register file base held in
+         // rbx when in reach and through rax otherwise.
+         void emit_memory(const unsigned char prefix, const unsigned char opcode,
+                          const unsigned char reg, const void* address);
+
+         void emit_load (const void* address);
+
+         void emit_store(const void* address);
+
+         void emit_move_imm(const unsigned char reg, const uint64_t value);
+
+         void emit_call(const uint64_t function);
+
+         void emit_test_true();
+
+         std::vector<unsigned char> code_;
+         const unsigned char*       base_;
+         void*                      memory_;
+         std::size_t                memory_size_;
+         function_t                 function_;
+      };
+   }
+}
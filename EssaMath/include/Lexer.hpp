@@ -32,11 +32,12 @@
 #pragma once
 
 #include "include/Defines.hpp"
+#include <string_view>
 
 namespace Essa::Math{
    namespace details{
       template <typename T>
-      bool string_to_real(const std::string& s, T& t);
+      bool string_to_real(std::string_view s, T& t);
 
       template <typename T>
       struct functor_t
@@ -100,6 +101,104 @@ namespace Essa::Math{
 
    namespace lexer
    {
+      // Token text as produced by the generator: a view into the source
+      // buffer held by the generator, or an owned copy once a helper has
+      // rewritten it or the token has to outlive the generator's buffer.
+      class token_string
+      {
+      public:
+
+         token_string()
+         : begin_(0)
+         , size_(0)
+         , view_(false)
+         {}
+
+         token_string(const char* s)
+         : begin_(0)
+         , size_(0)
+         , view_(false)
+         , owned_(s)
+         {}
+
+         token_string(const std::string& s)
+         : begin_(0)
+         , size_(0)
+         , view_(false)
+         , owned_(s)
+         {}
+
+         token_string& operator=(const std::string& s);
+
+         token_string& operator=(const char* s);
+
+         token_string& operator=(const char c);
+
+         void assign(const details::char_cptr begin, const details::char_cptr end)
+         {
+            begin_ = begin;
+            size_  = static_cast<std::size_t>(std::distance(begin,end));
+            view_  = true;
+         }
+
+         void detach();
+
+         const char* data() const
+         {
+            return view_ ? begin_ : owned_.data();
+         }
+
+         std::size_t size() const
+         {
+            return view_ ? size_ : owned_.size();
+         }
+
+         bool empty() const
+         {
+            return 0 == size();
+         }
+
+         char operator[](const std::size_t i) const
+         {
+            return data()[i];
+         }
+
+         std::string_view view() const
+         {
+            return std::string_view(data(),size());
+         }
+
+         std::string str() const
+         {
+            return std::string(data(),size());
+         }
+
+         operator std::string_view() const
+         {
+            return view();
+         }
+
+         operator std::string() const
+         {
+            return str();
+         }
+
+      private:
+
+         details::char_cptr begin_;
+         std::size_t        size_;
+         bool               view_;
+         std::string        owned_;
+      };
+
+      bool operator==(const token_string& s0, std::string_view s1);
+      bool operator!=(const token_string& s0, std::string_view s1);
+
+      std::string operator+(const std::string& s0, const token_string& s1);
+      std::string operator+(const char* s0, const token_string& s1);
+      std::string operator+(const token_string& s0, const std::string& s1);
+      std::string operator+(const token_string& s0, const char* s1);
+
       struct token
       {
          enum token_type
@@ -144,7 +243,7 @@ namespace Essa::Math{
          bool is_error() const;
 
          token_type type;
-         std::string value;
+         token_string value;
          std::size_t position;
       };
    }
@@ -40,6 +40,15 @@ namespace Essa::Math{
       {
       public:
 
+         node_allocator()
+         : allocated_bytes_(0)
+         {}
+
+         inline std::size_t allocated_bytes() const
+         {
+            return allocated_bytes_;
+         }
+
          template <typename ResultNode, typename OpType, typename ExprNode>
          inline expression_node<typename ResultNode::value_type>* allocate(OpType& operation, ExprNode (&branch)[1])
          {
@@ -97,7 +106,7 @@ namespace Essa::Math{
          template <typename node_type>
          inline expression_node<typename node_type::value_type>* allocate() const
          {
-            return (new node_type());
+            return track(new node_type());
          }
 
          template <typename node_type,
@@ -107,7 +116,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate(const Sequence<Type,Allocator>& seq) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(seq));
+            result = track(new node_type(seq));
             result->node_depth();
             return result;
          }
@@ -116,7 +125,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate(T1& t1) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1));
+            result = track(new node_type(t1));
             result->node_depth();
             return result;
          }
@@ -125,7 +134,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate(T1& t1, T2 t2) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2));
+            result = track(new node_type(t1, t2));
             result->node_depth();
             return result;
          }
@@ -134,7 +143,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_c(const T1& t1) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1));
+            result = track(new node_type(t1));
             result->node_depth();
             return result;
          }
@@ -144,7 +153,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate(const T1& t1, const T2& t2) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2));
+            result = track(new node_type(t1, t2));
             result->node_depth();
             return result;
          }
@@ -154,7 +163,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_cr(const T1& t1, T2& t2) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2));
+            result = track(new node_type(t1, t2));
             result->node_depth();
             return result;
          }
@@ -164,7 +173,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_rc(T1& t1, const T2& t2) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2));
+            result = track(new node_type(t1, t2));
             result->node_depth();
             return result;
          }
@@ -174,7 +183,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_rr(T1& t1, T2& t2) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2));
+            result = track(new node_type(t1, t2));
             result->node_depth();
             return result;
          }
@@ -184,7 +193,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_tt(T1 t1, T2 t2) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2));
+            result = track(new node_type(t1, t2));
             result->node_depth();
             return result;
          }
@@ -194,7 +203,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_ttt(T1 t1, T2 t2, T3 t3) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3));
+            result = track(new node_type(t1, t2, t3));
             result->node_depth();
             return result;
          }
@@ -204,7 +213,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_tttt(T1 t1, T2 t2, T3 t3, T4 t4) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4));
+            result = track(new node_type(t1, t2, t3, t4));
             result->node_depth();
             return result;
          }
@@ -214,7 +223,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_rrr(T1& t1, T2& t2, T3& t3) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3));
+            result = track(new node_type(t1, t2, t3));
             result->node_depth();
             return result;
          }
@@ -224,7 +233,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_rrrr(T1& t1, T2& t2, T3& t3, T4& t4) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4));
+            result = track(new node_type(t1, t2, t3, t4));
             result->node_depth();
             return result;
          }
@@ -234,7 +243,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_rrrrr(T1& t1, T2& t2, T3& t3, T4& t4, T5& t5) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4, t5));
+            result = track(new node_type(t1, t2, t3, t4, t5));
             result->node_depth();
             return result;
          }
@@ -245,7 +254,7 @@ namespace Essa::Math{
                                                                           const T3& t3) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3));
+            result = track(new node_type(t1, t2, t3));
             result->node_depth();
             return result;
          }
@@ -257,7 +266,7 @@ namespace Essa::Math{
                                                                           const T3& t3, const T4& t4) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4));
+            result = track(new node_type(t1, t2, t3, t4));
             result->node_depth();
             return result;
          }
@@ -270,7 +279,7 @@ namespace Essa::Math{
                                                                           const T5& t5) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4, t5));
+            result = track(new node_type(t1, t2, t3, t4, t5));
             result->node_depth();
             return result;
          }
@@ -283,7 +292,7 @@ namespace Essa::Math{
                                                                           const T5& t5, const T6& t6) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4, t5, t6));
+            result = track(new node_type(t1, t2, t3, t4, t5, t6));
             result->node_depth();
             return result;
          }
@@ -298,7 +307,7 @@ namespace Essa::Math{
                                                                           const T7& t7) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4, t5, t6, t7));
+            result = track(new node_type(t1, t2, t3, t4, t5, t6, t7));
             result->node_depth();
             return result;
          }
@@ -314,7 +323,7 @@ namespace Essa::Math{
                                                                           const T7& t7, const T8& t8) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4, t5, t6, t7, t8));
+            result = track(new node_type(t1, t2, t3, t4, t5, t6, t7, t8));
             result->node_depth();
             return result;
          }
@@ -331,7 +340,7 @@ namespace Essa::Math{
                                                                           const T9& t9) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4, t5, t6, t7, t8, t9));
+            result = track(new node_type(t1, t2, t3, t4, t5, t6, t7, t8, t9));
             result->node_depth();
             return result;
          }
@@ -349,7 +358,7 @@ namespace Essa::Math{
                                                                           const T9& t9, const T10& t10) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4, t5, t6, t7, t8, t9, t10));
+            result = track(new node_type(t1, t2, t3, t4, t5, t6, t7, t8, t9, t10));
             result->node_depth();
             return result;
          }
@@ -359,7 +368,7 @@ namespace Essa::Math{
          inline expression_node<typename node_type::value_type>* allocate_type(T1 t1, T2 t2, T3 t3) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3));
+            result = track(new node_type(t1, t2, t3));
             result->node_depth();
             return result;
          }
@@ -371,7 +380,7 @@ namespace Essa::Math{
                                                                                T3 t3, T4 t4) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4));
+            result = track(new node_type(t1, t2, t3, t4));
             result->node_depth();
             return result;
          }
@@ -385,7 +394,7 @@ namespace Essa::Math{
                                                                                T5 t5) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4, t5));
+            result = track(new node_type(t1, t2, t3, t4, t5));
             result->node_depth();
             return result;
          }
@@ -399,7 +408,7 @@ namespace Essa::Math{
                                                                                T5 t5, T6 t6) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4, t5, t6));
+            result = track(new node_type(t1, t2, t3, t4, t5, t6));
             result->node_depth();
             return result;
          }
@@ -414,7 +423,7 @@ namespace Essa::Math{
                                                                                T7 t7) const
          {
             expression_node<typename node_type::value_type>*
-            result = (new node_type(t1, t2, t3, t4, t5, t6, t7));
+            result = track(new node_type(t1, t2, t3, t4, t5, t6, t7));
             result->node_depth();
             return result;
          }
@@ -429,6 +438,17 @@ namespace Essa::Math{
             delete e;
             e = 0;
          }
+
+      private:
+
+         template <typename node_type>
+         inline node_type* track(node_type* node) const
+         {
+            allocated_bytes_ += sizeof(node_type);
+            return node;
+         }
+
+         mutable std::size_t allocated_bytes_;
       };
    }
 }
\ No newline at end of file
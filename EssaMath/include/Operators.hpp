@@ -1022,6 +1022,16 @@ namespace Essa::Math{
 
             const T* upper_bound = vec + lud.upper_bound;
 
+            // The kernel consumes every full batch, leaving the loop below
+            // nothing but the remainder to handle.
+            const typename vector_kernels<T>::reduce_t kernel = vector_kernels<T>::sum();
+
+            if (kernel)
+            {
+               kernel(vec, vec_size - lud.remainder, r);
+               vec += vec_size - lud.remainder;
+            }
+
             while (vec < upper_bound)
             {
                #define exprtk_loop(N) \
@@ -1116,6 +1126,14 @@ namespace Essa::Math{
 
             const T* upper_bound = vec + lud.upper_bound;
 
+            const typename vector_kernels<T>::reduce_t kernel = vector_kernels<T>::product();
+
+            if (kernel)
+            {
+               kernel(vec, vec_size - lud.remainder, r);
+               vec += vec_size - lud.remainder;
+            }
+
             while (vec < upper_bound)
             {
                #define exprtk_loop(N) \
@@ -42,6 +42,9 @@
 #include "include/Functions.hpp"
 #include "include/SymbolTable.hpp"
 #include "include/Expression.hpp"
+#include <chrono>
+#include <map>
+#include <memory>
 
 namespace Essa::Math{
    namespace parser_error
@@ -766,7 +769,11 @@ namespace Essa::Math{
             e_collect_funcs        =  512,
             e_collect_assings      = 1024,
             e_disable_usr_on_rsrvd = 2048,
-            e_disable_zero_return  = 4096
+            e_disable_zero_return  = 4096,
+            e_common_subexpr       = 8192,
+            e_memoise              = 16384,
+            e_vector_math          = 32768,
+            e_loop_invariant       = 65536
          };
 
          enum settings_base_funcs
@@ -881,6 +888,10 @@ namespace Essa::Math{
          bool vardef_disabled            () const;
          bool rsrvd_sym_usr_disabled     () const;
          bool zero_return_disabled       () const;
+         bool common_subexpr_enabled     () const;
+         bool memoise_enabled            () const;
+         bool vector_math_enabled        () const;
+         bool loop_invariant_enabled     () const;
 
          bool function_enabled(const std::string& function_name) const;
 
@@ -961,6 +972,10 @@ namespace Essa::Math{
          bool disable_vardef_;
          bool disable_rsrvd_sym_usr_;
          bool disable_zero_return_;
+         bool enable_common_subexpr_;
+         bool enable_memoise_;
+         bool enable_vector_math_;
+         bool enable_loop_invariant_;
 
          disabled_entity_set_t disabled_func_set_ ;
          disabled_entity_set_t disabled_ctrl_set_ ;
@@ -977,6 +992,52 @@ namespace Essa::Math{
 
       typedef settings_store settings_t;
 
+      // Filled in by every compile while registered with the parser. Times
+      // are wall clock seconds. parse_time covers parse_corpus as a whole,
+      // synthesis_time is the part of it spent inside expression_generator.
+      // hoist_time covers moving loop invariants out of loops, cse_time
+      // common subexpression elimination of the parsed tree and memo_time
+      // the insertion of memo nodes.
+      // Node counts cover the nodes owned by the final tree, variables are
+      // owned by their symbol table and are not included.
+      struct compile_stats
+      {
+         typedef std::map<typename details::expression_node<T>::node_type, std::size_t> node_type_count_t;
+
+         compile_stats()
+         : lexer_time     (0.0)
+         , assembly_time  (0.0)
+         , parse_time     (0.0)
+         , synthesis_time (0.0)
+         , hoist_time     (0.0)
+         , cse_time       (0.0)
+         , memo_time      (0.0)
+         , display_time   (0.0)
+         , total_time     (0.0)
+         , token_count    (0)
+         , node_count     (0)
+         , node_depth     (0)
+         , bytes_allocated(0)
+         {}
+
+         double lexer_time;
+         double assembly_time;
+         double parse_time;
+         double synthesis_time;
+         double hoist_time;
+         double cse_time;
+         double memo_time;
+         double display_time;
+         double total_time;
+
+         std::size_t token_count;
+         std::size_t node_count;
+         std::size_t node_depth;
+         std::size_t bytes_allocated;
+
+         node_type_count_t node_type_count;
+      };
+
       parser(const settings_t& settings = settings_t());
 
      ~parser() {}
@@ -991,6 +1052,7 @@ namespace Essa::Math{
 
       settings_store& settings()
       {
+         display_settings_.reset();
          return settings_;
       }
 
@@ -1018,10 +1080,18 @@ namespace Essa::Math{
 
       void clear_loop_runtime_check();
 
+      // While registered, compile also builds the display tree up front so
+      // that its cost is part of the numbers reported.
+      void register_compile_stats(compile_stats& stats);
+
+      void clear_compile_stats();
+
       bool simplify_unary_negation_branch(expression_node_ptr& node);
 
    private:
 
+      bool compile_tree(const std::string& expression_string, expression<T>& expr, const bool display_tree);
+
       bool valid_base_operation(const std::string& symbol) const;
 
       bool valid_vararg_operation(const std::string& symbol) const;
@@ -1040,6 +1110,36 @@ namespace Essa::Math{
 
       expression_node_ptr parse_corpus();
 
+      void collect_node_stats(expression_node_ptr root);
+
+      class phase_timer
+      {
+      public:
+
+         explicit phase_timer(double* phase_time)
+         : phase_time_(phase_time)
+         {
+            if (phase_time_)
+               start_ = std::chrono::steady_clock::now();
+         }
+
+        ~phase_timer()
+         {
+            if (phase_time_)
+               *phase_time_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+         }
+
+      private:
+
+         phase_timer(const phase_timer&) exprtk_delete;
+         phase_timer& operator=(const phase_timer&) exprtk_delete;
+
+         double* phase_time_;
+         std::chrono::steady_clock::time_point start_;
+      };
+
+      double* phase_time(double compile_stats::* phase);
+
       std::string construct_subexpr(lexer::token& begin_token, lexer::token& end_token);
 
       static const precedence_level default_precedence;
@@ -1712,6 +1812,7 @@ namespace Essa::Math{
       parser<T>& operator=(const parser<T>&) exprtk_delete;
 
       settings_store settings_;
+      std::shared_ptr<const settings_store> display_settings_;
       expression_generator<T> expression_generator_;
       details::node_allocator node_allocator_;
       symtab_store symtab_store_;
@@ -1747,6 +1848,7 @@ namespace Essa::Math{
       lexer::helper::sequence_validator_3tokens sequence_validator_3tkns_;
 
       loop_runtime_check_ptr loop_runtime_check_;
+      compile_stats* compile_stats_;
 
       template <typename ParserType>
       friend void details::disable_type_checking(ParserType& p);
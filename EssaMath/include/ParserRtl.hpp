@@ -33,6 +33,7 @@
 
 #include "include/SymbolTable.hpp"
 #include "include/Functions.hpp"
+#include "include/VectorKernels.hpp"
 #include <algorithm>
 
 #ifndef exprtk_disable_rtl_io
@@ -742,6 +743,78 @@ namespace Essa::Math
          sum = y;
       }
 
+      // Work on the elements [r0, r1] of the arguments of a vecops
+      // function, with x, y and z pointing at element r0. Reductions keep
+      // one partial result per chunk of the vector_thread_pool and add
+      // them in chunk order.
+      template <typename T>
+      struct range_task
+      {
+         typedef Essa::Math::details::vector_thread_pool pool_t;
+
+         explicit range_task(const std::size_t n)
+         : x(0)
+         , y(0)
+         , z(0)
+         , a(T(0))
+         , b(T(0))
+         , sum(0)
+         , error(0)
+         , size(n)
+         {}
+
+         void run(pool_t::task_t task)
+         {
+            pool_t::run(task, this, size);
+         }
+
+         T reduce(pool_t::task_t task, const bool compensated)
+         {
+            T local_sum   = T(0);
+            T local_error = T(0);
+
+            const std::size_t chunks = pool_t::chunk_count(size);
+
+            if (1 == chunks)
+            {
+               sum   = &local_sum;
+               error = &local_error;
+               task(this, 0, 0, size);
+
+               return local_sum;
+            }
+
+            std::vector<T> sum_list  (chunks, T(0));
+            std::vector<T> error_list(chunks, T(0));
+
+            sum   = &sum_list  [0];
+            error = &error_list[0];
+            pool_t::run(task, this, size);
+
+            for (std::size_t i = 0; i < chunks; ++i)
+            {
+               if (compensated)
+               {
+                  kahan_sum(local_sum, local_error,  sum_list  [i]);
+                  kahan_sum(local_sum, local_error, T(-error_list[i]));
+               }
+               else
+                  local_sum += sum_list[i];
+            }
+
+            return local_sum;
+         }
+
+         const T* x;
+         const T* y;
+               T* z;
+         T a;
+         T b;
+         T* sum;
+         T* error;
+         std::size_t size;
+      };
+
    } // namespace Essa::Math::rtl::details
 
    template <typename T>
@@ -1437,15 +1510,28 @@ namespace Essa::Math
          if ((1 == ps_index) && !helper::load_vector_range<T>::process(parameters, r0, r1, 1, 2, 0))
             return std::numeric_limits<T>::quiet_NaN();
 
+         details::range_task<T> t(r1 - r0 + 1);
+         t.x = vec.begin() + r0;
+
+         return t.reduce(&process, true);
+      }
+
+   private:
+
+      static void process(void* context, const std::size_t chunk, const std::size_t begin, const std::size_t end)
+      {
+         details::range_task<T>& t = *static_cast<details::range_task<T>*>(context);
+
          T result = T(0);
          T error  = T(0);
 
-         for (std::size_t i = r0; i <= r1; ++i)
+         for (std::size_t i = begin; i < end; ++i)
          {
-            details::kahan_sum(result, error, vec[i]);
+            details::kahan_sum(result, error, t.x[i]);
          }
 
-         return result;
+         t.sum  [chunk] = result;
+         t.error[chunk] = error;
       }
    };
 
@@ -1485,15 +1571,27 @@ namespace Essa::Math
          else if (helper::invalid_range(y, r0, r1))
             return std::numeric_limits<T>::quiet_NaN();
 
-         const T a = scalar_t(parameters[0])();
+         details::range_task<T> t(r1 - r0 + 1);
+         t.a = scalar_t(parameters[0])();
+         t.x = x.begin() + r0;
+         t.z = y.begin() + r0;
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            y[i] = (a * x[i]) + y[i];
-         }
+         t.run(&process);
 
          return T(1);
       }
+
+   private:
+
+      static void process(void* context, const std::size_t, const std::size_t begin, const std::size_t end)
+      {
+         const details::range_task<T>& t = *static_cast<const details::range_task<T>*>(context);
+
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            t.z[i] = (t.a * t.x[i]) + t.z[i];
+         }
+      }
    };
 
    template <typename T>
@@ -1532,16 +1630,28 @@ namespace Essa::Math
          else if (helper::invalid_range(y, r0, r1))
             return std::numeric_limits<T>::quiet_NaN();
 
-         const T a = scalar_t(parameters[0])();
-         const T b = scalar_t(parameters[2])();
+         details::range_task<T> t(r1 - r0 + 1);
+         t.a = scalar_t(parameters[0])();
+         t.b = scalar_t(parameters[2])();
+         t.x = x.begin() + r0;
+         t.z = y.begin() + r0;
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            y[i] = (a * x[i]) + (b * y[i]);
-         }
+         t.run(&process);
 
          return T(1);
       }
+
+   private:
+
+      static void process(void* context, const std::size_t, const std::size_t begin, const std::size_t end)
+      {
+         const details::range_task<T>& t = *static_cast<const details::range_task<T>*>(context);
+
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            t.z[i] = (t.a * t.x[i]) + (t.b * t.z[i]);
+         }
+      }
    };
 
    template <typename T>
@@ -1583,15 +1693,28 @@ namespace Essa::Math
          else if (helper::invalid_range(z, r0, r1))
             return std::numeric_limits<T>::quiet_NaN();
 
-         const T a = scalar_t(parameters[0])();
+         details::range_task<T> t(r1 - r0 + 1);
+         t.a = scalar_t(parameters[0])();
+         t.x = x.begin() + r0;
+         t.y = y.begin() + r0;
+         t.z = z.begin() + r0;
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            z[i] = (a * x[i]) + y[i];
-         }
+         t.run(&process);
 
          return T(1);
       }
+
+   private:
+
+      static void process(void* context, const std::size_t, const std::size_t begin, const std::size_t end)
+      {
+         const details::range_task<T>& t = *static_cast<const details::range_task<T>*>(context);
+
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            t.z[i] = (t.a * t.x[i]) + t.y[i];
+         }
+      }
    };
 
    template <typename T>
@@ -1633,16 +1756,29 @@ namespace Essa::Math
          else if (helper::invalid_range(z, r0, r1))
             return std::numeric_limits<T>::quiet_NaN();
 
-         const T a = scalar_t(parameters[0])();
-         const T b = scalar_t(parameters[2])();
+         details::range_task<T> t(r1 - r0 + 1);
+         t.a = scalar_t(parameters[0])();
+         t.b = scalar_t(parameters[2])();
+         t.x = x.begin() + r0;
+         t.y = y.begin() + r0;
+         t.z = z.begin() + r0;
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            z[i] = (a * x[i]) + (b * y[i]);
-         }
+         t.run(&process);
 
          return T(1);
       }
+
+   private:
+
+      static void process(void* context, const std::size_t, const std::size_t begin, const std::size_t end)
+      {
+         const details::range_task<T>& t = *static_cast<const details::range_task<T>*>(context);
+
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            t.z[i] = (t.a * t.x[i]) + (t.b * t.y[i]);
+         }
+      }
    };
 
    template <typename T>
@@ -1681,16 +1817,28 @@ namespace Essa::Math
          else if (helper::invalid_range(z, r0, r1))
             return std::numeric_limits<T>::quiet_NaN();
 
-         const T a = scalar_t(parameters[0])();
-         const T b = scalar_t(parameters[2])();
+         details::range_task<T> t(r1 - r0 + 1);
+         t.a = scalar_t(parameters[0])();
+         t.b = scalar_t(parameters[2])();
+         t.x = x.begin() + r0;
+         t.z = z.begin() + r0;
 
-         for (std::size_t i = r0; i <= r1; ++i)
-         {
-            z[i] = (a * x[i]) + b;
-         }
+         t.run(&process);
 
          return T(1);
       }
+
+   private:
+
+      static void process(void* context, const std::size_t, const std::size_t begin, const std::size_t end)
+      {
+         const details::range_task<T>& t = *static_cast<const details::range_task<T>*>(context);
+
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            t.z[i] = (t.a * t.x[i]) + t.b;
+         }
+      }
    };
 
    template <typename T>
@@ -1728,14 +1876,27 @@ namespace Essa::Math
          else if (helper::invalid_range(y, r0, r1))
             return std::numeric_limits<T>::quiet_NaN();
 
+         details::range_task<T> t(r1 - r0 + 1);
+         t.x = x.begin() + r0;
+         t.y = y.begin() + r0;
+
+         return t.reduce(&process, false);
+      }
+
+   private:
+
+      static void process(void* context, const std::size_t chunk, const std::size_t begin, const std::size_t end)
+      {
+         details::range_task<T>& t = *static_cast<details::range_task<T>*>(context);
+
          T result = T(0);
 
-         for (std::size_t i = r0; i <= r1; ++i)
+         for (std::size_t i = begin; i < end; ++i)
          {
-            result += (x[i] * y[i]);
+            result += (t.x[i] * t.y[i]);
          }
 
-         return result;
+         t.sum[chunk] = result;
       }
    };
 
@@ -1774,15 +1935,29 @@ namespace Essa::Math
          else if (helper::invalid_range(y, r0, r1))
             return std::numeric_limits<T>::quiet_NaN();
 
+         details::range_task<T> t(r1 - r0 + 1);
+         t.x = x.begin() + r0;
+         t.y = y.begin() + r0;
+
+         return t.reduce(&process, true);
+      }
+
+   private:
+
+      static void process(void* context, const std::size_t chunk, const std::size_t begin, const std::size_t end)
+      {
+         details::range_task<T>& t = *static_cast<details::range_task<T>*>(context);
+
          T result = T(0);
          T error  = T(0);
 
-         for (std::size_t i = r0; i <= r1; ++i)
+         for (std::size_t i = begin; i < end; ++i)
          {
-            details::kahan_sum(result, error, (x[i] * y[i]));
+            details::kahan_sum(result, error, (t.x[i] * t.y[i]));
          }
 
-         return result;
+         t.sum  [chunk] = result;
+         t.error[chunk] = error;
       }
    };
 
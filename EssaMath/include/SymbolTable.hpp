@@ -33,8 +33,13 @@
 
 #include "include/Functions.hpp"
 #include "include/ExpressionNodes.hpp"
+#include <algorithm>
+#include <atomic>
 #include <list>
 #include <set>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace Essa::Math{
    template <typename T>
@@ -293,14 +298,17 @@ namespace Essa::Math{
          typedef Type type_t;
          typedef type_t* type_ptr;
          typedef std::pair<bool,type_ptr> type_pair_t;
-         typedef std::map<std::string,type_pair_t,details::ilesscompare> type_map_t;
+         typedef std::unordered_map<std::string,type_pair_t,details::ihash,details::iequal_to> type_map_t;
          typedef typename type_map_t::iterator tm_itr_t;
          typedef typename type_map_t::const_iterator tm_const_itr_t;
+         typedef std::unordered_multimap<const void*,const std::string*> name_index_t;
+         typedef std::unordered_map<const void*,type_ptr> ref_index_t;
+         typedef typename name_index_t::const_iterator ni_const_itr_t;
 
-         enum { lut_size = 256 };
-
-         type_map_t  map;
-         std::size_t size;
+         type_map_t   map;
+         name_index_t name_index;
+         ref_index_t  ref_index;
+         std::size_t  size;
 
          type_store()
          : size(0)
@@ -341,16 +349,11 @@ namespace Essa::Math{
             if (map.empty())
                return std::string();
 
-            tm_const_itr_t itr = map.begin();
+            const ni_const_itr_t itr = name_index.find(index_key(ptr));
 
-            while (map.end() != itr)
+            if (name_index.end() != itr)
             {
-               if (itr->second.second == ptr)
-               {
-                  return itr->first;
-               }
-               else
-                  ++itr;
+               return *itr->second;
             }
 
             return std::string();
@@ -374,22 +377,16 @@ namespace Essa::Math{
          template <typename Tie, typename RType>
          inline bool add_impl(const std::string& symbol_name, RType t, const bool is_const)
          {
-            if (symbol_name.size() > 1)
+            if ((symbol_name.size() > 1) && details::is_reserved_symbol(symbol_name))
             {
-               for (std::size_t i = 0; i < details::reserved_symbols_size; ++i)
-               {
-                  if (details::imatch(symbol_name, details::reserved_symbols[i]))
-                  {
-                     return false;
-                  }
-               }
+               return false;
             }
 
             const tm_itr_t itr = map.find(symbol_name);
 
             if (map.end() == itr)
             {
-               map[symbol_name] = Tie::make(t,is_const);
+               index_insert(map.insert(std::make_pair(symbol_name, Tie::make(t,is_const))).first);
                ++size;
             }
 
@@ -472,22 +469,22 @@ namespace Essa::Math{
                   return std::make_pair(is_constant, new variable_node_t(t, _name));
                }
 
-               static inline std::pair<bool,stringvar_node_t*> make(std::string& t, const bool is_constant = false)
+               static inline std::pair<bool,stringvar_node_t*> make(std::string& t, const std::string&, const bool is_constant = false)
                {
                   return std::make_pair(is_constant, new stringvar_node_t(t));
                }
 
-               static inline std::pair<bool,function_t*> make(function_t& t, const bool is_constant = false)
+               static inline std::pair<bool,function_t*> make(function_t& t, const std::string&, const bool is_constant = false)
                {
                   return std::make_pair(is_constant,&t);
                }
 
-               static inline std::pair<bool,vararg_function_t*> make(vararg_function_t& t, const bool is_constant = false)
+               static inline std::pair<bool,vararg_function_t*> make(vararg_function_t& t, const std::string&, const bool is_constant = false)
                {
                   return std::make_pair(is_constant,&t);
                }
 
-               static inline std::pair<bool,generic_function_t*> make(generic_function_t& t, const bool is_constant = false)
+               static inline std::pair<bool,generic_function_t*> make(generic_function_t& t, const std::string&, const bool is_constant = false)
                {
                   return std::make_pair(is_constant,&t);
                }
@@ -497,13 +494,20 @@ namespace Essa::Math{
 
             if (map.end() == itr)
             {
-               map[symbol_name] = tie::make(t_, symbol_name, is_const);
+               index_insert(map.insert(std::make_pair(symbol_name, tie::make(t_, symbol_name, is_const))).first);
                ++size;
             }
 
             return true;
          }
 
+         inline void reserve(const std::size_t count)
+         {
+            map       .reserve(map.size() + count);
+            name_index.reserve(map.size() + count);
+            ref_index .reserve(ref_index.size() + count);
+         }
+
          inline type_ptr get(const std::string& symbol_name) const
          {
             const tm_const_itr_t itr = map.find(symbol_name);
@@ -533,8 +537,36 @@ namespace Essa::Math{
             }
          };
 
+         template <typename TType, typename TRawType, typename PtrType>
+         struct ref_address
+         {
+            static inline const void* get(const PtrType)
+            {
+               return 0;
+            }
+         };
+
+         template <typename TType, typename TRawType>
+         struct ref_address<TType,TRawType,variable_node_t*>
+         {
+            static inline const void* get(const variable_node_t* p)
+            {
+               return &(p->ref());
+            }
+         };
+
          inline type_ptr get_from_varptr(const void* ptr) const
          {
+            if (!ref_index.empty())
+            {
+               const typename ref_index_t::const_iterator ritr = ref_index.find(ptr);
+
+               if (ref_index.end() != ritr)
+               {
+                  return ritr->second;
+               }
+            }
+
             tm_const_itr_t itr = map.begin();
 
             while (map.end() != itr)
@@ -558,6 +590,8 @@ namespace Essa::Math{
 
             if (map.end() != itr)
             {
+               index_erase(itr);
+
                if (delete_node)
                {
                   deleter::process((*itr).second);
@@ -611,6 +645,9 @@ namespace Essa::Math{
                map.clear();
             }
 
+            name_index.clear();
+            ref_index .clear();
+
             size = 0;
          }
 
@@ -618,44 +655,111 @@ namespace Essa::Math{
                    template <typename, typename> class Sequence>
          inline std::size_t get_list(Sequence<std::pair<std::string,RawType>,Allocator>& list) const
          {
-            std::size_t count = 0;
+            const std::vector<tm_const_itr_t> entries = sorted_entries();
 
-            if (!map.empty())
+            for (std::size_t i = 0; i < entries.size(); ++i)
             {
-               tm_const_itr_t itr = map.begin();
-               tm_const_itr_t end = map.end  ();
-
-               while (end != itr)
-               {
-                  list.push_back(std::make_pair((*itr).first,itr->second.second->ref()));
-                  ++itr;
-                  ++count;
-               }
+               list.push_back(std::make_pair(entries[i]->first,entries[i]->second.second->ref()));
             }
 
-            return count;
+            return entries.size();
          }
 
          template <typename Allocator,
                    template <typename, typename> class Sequence>
          inline std::size_t get_list(Sequence<std::string,Allocator>& vlist) const
          {
-            std::size_t count = 0;
+            const std::vector<tm_const_itr_t> entries = sorted_entries();
 
-            if (!map.empty())
+            for (std::size_t i = 0; i < entries.size(); ++i)
+            {
+               vlist.push_back(entries[i]->first);
+            }
+
+            return entries.size();
+         }
+
+      private:
+
+         // Entities can be looked up through a base class pointer, so the
+         // name index is keyed on the address of the complete object.
+         template <typename PtrType>
+         static inline const void* index_key(const PtrType* p)
+         {
+            if constexpr (std::is_polymorphic<PtrType>::value)
+               return dynamic_cast<const void*>(p);
+            else
+               return static_cast<const void*>(p);
+         }
+
+         // name_index and ref_index point back into map, whose node based
+         // keys stay put across rehashing. Both follow every insert/erase.
+         inline void index_insert(const tm_itr_t& itr)
+         {
+            const type_ptr p = itr->second.second;
+
+            name_index.insert(std::make_pair(index_key(p), &itr->first));
+
+            const void* ref = ref_address<Type,RawType,type_ptr>::get(p);
+
+            if (ref)
             {
-               tm_const_itr_t itr = map.begin();
-               tm_const_itr_t end = map.end  ();
+               ref_index.insert(std::make_pair(ref, p));
+            }
+         }
+
+         inline void index_erase(const tm_itr_t& itr)
+         {
+            const type_ptr p = itr->second.second;
+
+            std::pair<typename name_index_t::iterator,typename name_index_t::iterator> range =
+               name_index.equal_range(index_key(p));
 
-               while (end != itr)
+            for (typename name_index_t::iterator nitr = range.first; nitr != range.second; ++nitr)
+            {
+               if (nitr->second == &itr->first)
                {
-                  vlist.push_back((*itr).first);
-                  ++itr;
-                  ++count;
+                  name_index.erase(nitr);
+                  break;
                }
             }
 
-            return count;
+            const void* ref = ref_address<Type,RawType,type_ptr>::get(p);
+
+            if (ref)
+            {
+               const typename ref_index_t::iterator ritr = ref_index.find(ref);
+
+               if ((ref_index.end() != ritr) && (ritr->second == p))
+               {
+                  ref_index.erase(ritr);
+               }
+            }
+         }
+
+         // The store is hashed, listings are still handed out in the
+         // case-insensitive name order the original map provided.
+         inline std::vector<tm_const_itr_t> sorted_entries() const
+         {
+            struct name_order
+            {
+               bool operator() (const tm_const_itr_t& i0, const tm_const_itr_t& i1) const
+               {
+                  return details::ilesscompare()(i0->first, i1->first);
+               }
+            };
+
+            std::vector<tm_const_itr_t> entries;
+            entries.reserve(map.size());
+
+            for (tm_const_itr_t itr = map.begin(); map.end() != itr; ++itr)
+            {
+               entries.push_back(itr);
+            }
+
+            std::sort(entries.begin(), entries.end(), name_order());
+
+            return entries;
          }
       };
 
@@ -689,17 +793,7 @@ namespace Essa::Math{
             type_store<stringvar_t       , std::string       > stringvar_store;
 
             st_data()
-            {
-               for (std::size_t i = 0; i < details::reserved_words_size; ++i)
-               {
-                  reserved_symbol_table_.insert(details::reserved_words[i]);
-               }
-
-               for (std::size_t i = 0; i < details::reserved_symbols_size; ++i)
-               {
-                  reserved_symbol_table_.insert(details::reserved_symbols[i]);
-               }
-            }
+            {}
 
            ~st_data()
             {
@@ -711,7 +805,7 @@ namespace Essa::Math{
 
             inline bool is_reserved_symbol(const std::string& symbol) const
             {
-               return (reserved_symbol_table_.end() != reserved_symbol_table_.find(symbol));
+               return details::is_reserved_symbol(symbol);
             }
 
             static inline st_data* create()
@@ -727,7 +821,6 @@ namespace Essa::Math{
 
             std::list<T>               local_symbol_list_;
             std::list<std::string>     local_stringvar_list_;
-            std::set<std::string>      reserved_symbol_table_;
             std::vector<ifunction<T>*> free_function_list_;
          };
 
@@ -781,7 +874,7 @@ namespace Essa::Math{
             mutability_ = mutability;
          }
 
-         std::size_t ref_count;
+         std::atomic<std::size_t> ref_count;
          st_data* data_;
          symtab_mutability_type mutability_;
       };
@@ -1119,6 +1212,59 @@ namespace Essa::Math{
             return local_data().stringvar_store.add(stringvar_name, s, is_constant);
       }
 
+      // Batch registration: every name is validated before anything is
+      // inserted, so either all entries are added or none are.
+      inline bool add_variables(const std::vector<std::string>& variable_names, const std::vector<T*>& variables, const bool is_constant = false)
+      {
+         if (!valid_batch(variable_names, variables.size()))
+            return false;
+
+         local_data().variable_store.reserve(variable_names.size());
+
+         for (std::size_t i = 0; i < variable_names.size(); ++i)
+         {
+            local_data().variable_store.add(variable_names[i], *variables[i], is_constant);
+         }
+
+         return true;
+      }
+
+      inline bool add_stringvars(const std::vector<std::string>& stringvar_names, const std::vector<std::string*>& stringvars, const bool is_constant = false)
+      {
+         if (!valid_batch(stringvar_names, stringvars.size()))
+            return false;
+
+         local_data().stringvar_store.reserve(stringvar_names.size());
+
+         for (std::size_t i = 0; i < stringvar_names.size(); ++i)
+         {
+            local_data().stringvar_store.add(stringvar_names[i], *stringvars[i], is_constant);
+         }
+
+         return true;
+      }
+
+      inline bool add_vectors(const std::vector<std::string>& vector_names, const std::vector<std::pair<T*,std::size_t> >& vectors)
+      {
+         if (!valid_batch(vector_names, vectors.size()))
+            return false;
+
+         for (std::size_t i = 0; i < vectors.size(); ++i)
+         {
+            if (0 == vectors[i].second)
+               return false;
+         }
+
+         local_data().vector_store.reserve(vector_names.size());
+
+         for (std::size_t i = 0; i < vector_names.size(); ++i)
+         {
+            local_data().vector_store.add(vector_names[i], vectors[i].first, vectors[i].second);
+         }
+
+         return true;
+      }
+
       inline bool add_function(const std::string& function_name, function_t& function)
       {
          if (!valid())
@@ -1447,6 +1593,16 @@ namespace Essa::Math{
             return local_data().vector_store.get_list(vlist);
       }
 
+      template <typename Allocator,
+                template <typename, typename> class Sequence>
+      inline std::size_t get_function_list(Sequence<std::string,Allocator>& flist) const
+      {
+         if (!valid())
+            return 0;
+         else
+            return local_data().function_store.get_list(flist);
+      }
+
       inline bool symbol_exists(const std::string& symbol_name, const bool check_reserved_symb = true) const
       {
          /*
@@ -1631,6 +1787,29 @@ namespace Essa::Math{
 
    private:
 
+      inline bool valid_batch(const std::vector<std::string>& names, const std::size_t entity_count) const
+      {
+         if (!valid())
+            return false;
+         else if (names.size() != entity_count)
+            return false;
+
+         std::unordered_set<std::string,details::ihash,details::iequal_to> batch_names;
+         batch_names.reserve(names.size());
+
+         for (std::size_t i = 0; i < names.size(); ++i)
+         {
+            if (!valid_symbol(names[i]))
+               return false;
+            else if (symbol_exists(names[i]))
+               return false;
+            else if (!batch_names.insert(names[i]).second)
+               return false;
+         }
+
+         return true;
+      }
+
       inline bool valid_symbol(const std::string& symbol, const bool check_reserved_symb = true) const
       {
          if (symbol.empty())
@@ -67,6 +67,8 @@ namespace Essa::Math{
 
          virtual bool operator() (const token&, const token&, const token&, const token&);
 
+         std::size_t stride() const;
+
       private:
 
          const std::size_t stride_;
@@ -111,6 +113,8 @@ namespace Essa::Math{
 
          #undef token_inserter_empty_body
 
+         std::size_t stride() const;
+
       private:
 
          const std::size_t stride_;
@@ -127,6 +131,8 @@ namespace Essa::Math{
          virtual bool join(const token&, const token&, token&)               { return false; }
          virtual bool join(const token&, const token&, const token&, token&) { return false; }
 
+         std::size_t stride() const;
+
       private:
 
          std::size_t process_stride_2(generator& g);
@@ -259,6 +265,8 @@ namespace Essa::Math{
 
             bool result();
 
+            void reset();
+
             bool operator() (const lexer::token& t0, const lexer::token& t1);
 
             std::size_t error_count() const;
@@ -295,6 +303,8 @@ namespace Essa::Math{
 
             bool result();
 
+            void reset();
+
             bool operator() (const lexer::token& t0, const lexer::token& t1, const lexer::token& t2);
 
             std::size_t error_count() const;
@@ -311,6 +321,57 @@ namespace Essa::Math{
             std::vector<std::pair<lexer::token,lexer::token> > error_list_;
          };
 
+         // Streams the generator's token list once through the registered
+         // inserters, joiners and modifiers (in that order) and hands each
+         // resulting token straight to the scanners, instead of rebuilding
+         // the list once per helper.
+         class assembly_pipeline
+         {
+         public:
+
+            typedef generator::token_list_t token_list_t;
+
+            assembly_pipeline(token_list_t& output);
+
+            void add_inserter(token_inserter* inserter);
+
+            void add_joiner(token_joiner* joiner);
+
+            void add_modifier(token_modifier* modifier);
+
+            void add_scanner(token_scanner* scanner);
+
+            void process(generator& g);
+
+         private:
+
+            enum stage_type
+            {
+               e_inserter,
+               e_joiner,
+               e_modifier
+            };
+
+            struct stage
+            {
+               stage_type         type;
+               helper_interface*  helper;
+               std::size_t        stride;
+               token_list_t       window;
+            };
+
+            void push(const std::size_t index, const token& t);
+
+            void flush(const std::size_t index);
+
+            void scan(const token& t);
+
+            std::vector<stage>          stage_list_;
+            std::vector<token_scanner*> scanner_list_;
+            std::vector<bool>           scanner_active_;
+            token_list_t&               output_;
+         };
+
          struct helper_assembly
          {
             bool register_scanner(lexer::token_scanner* scanner);
@@ -329,6 +390,15 @@ namespace Essa::Math{
 
             bool run_scanners(lexer::generator& g);
 
+            // Single pass equivalent of calling the enabled run_* methods in
+            // the order inserters, joiners, modifiers, scanners. Returns false
+            // only when a scanner fails, error_token_* are set as they would be.
+            bool run_assembly(lexer::generator& g,
+                              const bool inserters,
+                              const bool joiners,
+                              const bool modifiers,
+                              const bool scanners);
+
             std::vector<lexer::token_scanner*>  token_scanner_list;
             std::vector<lexer::token_modifier*> token_modifier_list;
             std::vector<lexer::token_joiner*>   token_joiner_list;
@@ -338,6 +408,8 @@ namespace Essa::Math{
             lexer::token_modifier* error_token_modifier;
             lexer::token_joiner*   error_token_joiner;
             lexer::token_inserter* error_token_inserter;
+
+            lexer::generator::token_list_t assembly_list;
          };
       }
    }
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "include/OperatorHelpers.hpp"
+
+namespace Essa::Math{
+   namespace details
+   {
+      // Worker threads shared by the vector operations. Work on at least
+      // threshold() elements is split into chunks of chunk_size elements
+      // that the workers and the calling thread take in turn. Chunk bounds
+      // depend on the size of the work alone, so per chunk results that
+      // are combined in chunk order do not depend on the thread count.
+      // Below the threshold, with a single thread, or while another thread
+      // runs work on the pool, the calling thread runs all chunks itself.
+      class vector_thread_pool
+      {
+      public:
+
+         typedef void (*task_t)(void* context, const std::size_t chunk,
+                                const std::size_t begin, const std::size_t end);
+
+         static const std::size_t chunk_size = 65536;
+
+         // Returns once task has run for every chunk of [0, size).
+         static void run(task_t task, void* context, const std::size_t size);
+
+         // One for work below the threshold.
+         static std::size_t chunk_count(const std::size_t size);
+
+         static std::size_t threshold();
+
+         static void set_threshold(const std::size_t size);
+
+         // Includes the calling thread.
+         static std::size_t thread_count();
+
+         // Zero selects one thread per hardware thread.
+         static void set_thread_count(const std::size_t count);
+
+      private:
+
+         struct state;
+
+         static state& instance();
+
+         static void work(state& s);
+
+         static void worker(state* s, std::size_t generation);
+      };
+
+      // SIMD implementations of the element wise vector operations and of
+      // the vector sum and product reductions. The widest instruction set
+      // the processor supports (SSE2, AVX2 or AVX-512) is picked once, on
+      // first use. Every query returns a null kernel for the operations,
+      // types and targets that have none, in which case callers keep their
+      // scalar loop. Kernels produce bit identical results to those loops.
+      template <typename T>
+      struct vector_kernels
+      {
+         typedef void (*vecvec_t)(const T* v0, const T* v1, T* result, const std::size_t size);
+         typedef void (*vecval_t)(const T* v0, const T& v1, T* result, const std::size_t size);
+         typedef void (*valvec_t)(const T& v0, const T* v1, T* result, const std::size_t size);
+         typedef void (*unary_t )(const T* v0, T* result, const std::size_t size);
+
+         // Folds the first size elements, a multiple of the loop batch size,
+         // into the batch size partial results, element i going to partial
+         // i modulo the batch size, the way vec_add_op and vec_mul_op do.
+         typedef void (*reduce_t)(const T* v0, const std::size_t size, T* partial);
+
+         static vecvec_t vecvec(const operator_type operation);
+
+         static vecval_t vecval(const operator_type operation);
+
+         static valvec_t valvec(const operator_type operation);
+
+         static unary_t unary(const operator_type operation);
+
+         static reduce_t sum();
+
+         static reduce_t product();
+
+         // Run the kernel over size elements, split across the
+         // vector_thread_pool when size reaches its threshold.
+         static void run(vecvec_t kernel, const T* v0, const T* v1, T* result, const std::size_t size);
+
+         static void run(vecval_t kernel, const T* v0, const T& v1, T* result, const std::size_t size);
+
+         static void run(valvec_t kernel, const T& v0, const T* v1, T* result, const std::size_t size);
+
+         static void run(unary_t  kernel, const T* v0, T* result, const std::size_t size);
+
+         // Name of the selected instruction set, "scalar" when none is.
+         static const char* isa();
+      };
+   }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "include/Lexer.hpp"
+#include "include/VectorKernels.hpp"
+
+namespace Essa::Math{
+   namespace details
+   {
+      // SIMD implementations of exp, expm1, log, sin, cos and tanh for
+      // float and double, which expressions compiled with the parser
+      // setting e_vector_math run in place of the library functions over
+      // vectors and in evaluate_batch(). Largest errors measured against
+      // a long double reference, in units in the last place:
+      //
+      //    function   float   double
+      //    exp        1       1
+      //    expm1      2       2
+      //    log        1       1
+      //    sin, cos   1       1
+      //    tanh       3       3
+      //
+      // Infinities, NaN, signed zeros and subnormal arguments and results
+      // give what the library gives. sin and cos call the library for
+      // arguments beyond 2^20 in magnitude, float arguments are reduced in
+      // double precision. Every instruction set computes the same results,
+      // which is picked as for vector_kernels.
+      template <typename T>
+      struct vector_math
+      {
+         typedef typename vector_kernels<T>::unary_t unary_t;
+         typedef typename functor_t<T>::ufunc_t      ufunc_t;
+
+         // Null for the operations, types and targets without a kernel.
+         static unary_t unary(const operator_type operation);
+
+         // The kernel of the unary operator whose process function is
+         // function.
+         static unary_t unary(ufunc_t function);
+
+         // Name of the selected instruction set, "scalar" when none is.
+         static const char* isa();
+      };
+   }
+}
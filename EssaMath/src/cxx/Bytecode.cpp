@@ -0,0 +1,1252 @@
+#include "include/Bytecode.hpp"
+#include "include/ExpressionNodes.hpp"
+#include "include/Functions.hpp"
+#include "include/Operators.hpp"
+#include "include/VectorKernels.hpp"
+#include "include/VectorMath.hpp"
+
+namespace Essa::Math{
+   namespace details
+   {
+      template<typename T> bytecode_program<T>::bytecode_program()
+      : result_(0)
+      , call_count_(0)
+      {}
+
+      template<typename T> T bytecode_program<T>::value() const
+      {
+         const instruction* const begin = &instruction_list_[0];
+         const instruction* inst = begin;
+
+         // With GCC and Clang every handler ends in its own indirect jump,
+         // which the branch predictor tracks separately, rather than all of
+         // them sharing the one jump of a switch.
+         #if defined(__GNUC__)
+         static const void* const handler_list[] =
+            {
+               &&op_halt       , &&op_mov        , &&op_add        , &&op_sub        ,
+               &&op_mul        , &&op_div        , &&op_neg        , &&op_ufunc      ,
+               &&op_bfunc      , &&op_tfunc      , &&op_qfunc      , &&op_jump       ,
+               &&op_jump_false , &&op_call       , &&op_vecvec     , &&op_vecval     ,
+               &&op_valvec     , &&op_vecunary   , &&op_select     , &&op_function
+            };
+         #endif
+
+         dispatch:
+
+         #if defined(__GNUC__)
+         goto *handler_list[inst->op];
+         #else
+         switch (inst->op)
+         {
+            case e_halt       : goto op_halt;
+            case e_mov        : goto op_mov;
+            case e_add        : goto op_add;
+            case e_sub        : goto op_sub;
+            case e_mul        : goto op_mul;
+            case e_div        : goto op_div;
+            case e_neg        : goto op_neg;
+            case e_ufunc      : goto op_ufunc;
+            case e_bfunc      : goto op_bfunc;
+            case e_tfunc      : goto op_tfunc;
+            case e_qfunc      : goto op_qfunc;
+            case e_jump       : goto op_jump;
+            case e_jump_false : goto op_jump_false;
+            case e_call       : goto op_call;
+            case e_vecvec     : goto op_vecvec;
+            case e_vecval     : goto op_vecval;
+            case e_valvec     : goto op_valvec;
+            case e_vecunary   : goto op_vecunary;
+            case e_select     : goto op_select;
+            case e_function   : goto op_function;
+         }
+         #endif
+
+         op_halt       : return (*result_);
+
+         op_mov        : *inst->r = *inst->a;
+                         ++inst;
+                         goto dispatch;
+
+         op_add        : *inst->r = *inst->a + *inst->b;
+                         ++inst;
+                         goto dispatch;
+
+         op_sub        : *inst->r = *inst->a - *inst->b;
+                         ++inst;
+                         goto dispatch;
+
+         op_mul        : *inst->r = *inst->a * *inst->b;
+                         ++inst;
+                         goto dispatch;
+
+         op_div        : *inst->r = *inst->a / *inst->b;
+                         ++inst;
+                         goto dispatch;
+
+         op_neg        : *inst->r = -(*inst->a);
+                         ++inst;
+                         goto dispatch;
+
+         op_ufunc      : *inst->r = inst->uf(*inst->a);
+                         ++inst;
+                         goto dispatch;
+
+         op_bfunc      : *inst->r = inst->bf(*inst->a, *inst->b);
+                         ++inst;
+                         goto dispatch;
+
+         op_tfunc      : *inst->r = inst->tf(*inst->a, *inst->b, *inst->c);
+                         ++inst;
+                         goto dispatch;
+
+         op_qfunc      : *inst->r = inst->qop->qf(*inst->a, *inst->b, *inst->c, *inst->qop->d);
+                         ++inst;
+                         goto dispatch;
+
+         op_jump       : inst = begin + inst->target;
+                         goto dispatch;
+
+         op_jump_false : if (is_true(*inst->a))
+                            ++inst;
+                         else
+                            inst = begin + inst->target;
+                         goto dispatch;
+
+         op_call       : *inst->r = inst->node->value();
+                         ++inst;
+                         goto dispatch;
+
+         op_select     : *inst->r = is_true(*inst->a) ? *inst->b : *inst->c;
+                         ++inst;
+                         goto dispatch;
+
+         op_vecvec     :
+         op_vecval     :
+         op_valvec     :
+         op_vecunary   :
+         op_function   : execute(*inst);
+                         ++inst;
+                         goto dispatch;
+      }
+
+      template<typename T> void bytecode_program<T>::execute(const instruction& inst)
+      {
+         switch (inst.op)
+         {
+            case e_mov      : *inst.r = *inst.a;
+                              break;
+
+            case e_add      : *inst.r = *inst.a + *inst.b;
+                              break;
+
+            case e_sub      : *inst.r = *inst.a - *inst.b;
+                              break;
+
+            case e_mul      : *inst.r = *inst.a * *inst.b;
+                              break;
+
+            case e_div      : *inst.r = *inst.a / *inst.b;
+                              break;
+
+            case e_neg      : *inst.r = -(*inst.a);
+                              break;
+
+            case e_ufunc    : *inst.r = inst.uf(*inst.a);
+                              break;
+
+            case e_bfunc    : *inst.r = inst.bf(*inst.a, *inst.b);
+                              break;
+
+            case e_tfunc    : *inst.r = inst.tf(*inst.a, *inst.b, *inst.c);
+                              break;
+
+            case e_qfunc    : *inst.r = inst.qop->qf(*inst.a, *inst.b, *inst.c, *inst.qop->d);
+                              break;
+
+            case e_call     : *inst.r = inst.node->value();
+                              break;
+
+            case e_select   : *inst.r = is_true(*inst.a) ? *inst.b : *inst.c;
+                              break;
+
+            case e_function : *inst.r = inst.fop->invoke(*inst.fop->function, inst.fop->argument_list.data());
+                              break;
+
+            case e_vecvec   : {
+                                 const vector_operation& vop = *inst.vop;
+                                 const T* vec0 = vop.v0->data();
+                                 const T* vec1 = vop.v1->data();
+                                       T* vec2 = vop.result->data();
+                                 const std::size_t n = vop.result->size();
+
+                                 for (std::size_t i = 0; i < n; ++i)
+                                 {
+                                    vec2[i] = vop.bf(vec0[i], vec1[i]);
+                                 }
+
+                                 *inst.r = vec2[0];
+                              }
+                              break;
+
+            case e_vecval   : {
+                                 const vector_operation& vop = *inst.vop;
+                                 const T* vec0 = vop.v0->data();
+                                       T* vec2 = vop.result->data();
+                                 const T  v    = *inst.b;
+                                 const std::size_t n = vop.result->size();
+
+                                 for (std::size_t i = 0; i < n; ++i)
+                                 {
+                                    vec2[i] = vop.bf(vec0[i], v);
+                                 }
+
+                                 *inst.r = vec2[0];
+                              }
+                              break;
+
+            case e_valvec   : {
+                                 const vector_operation& vop = *inst.vop;
+                                 const T* vec1 = vop.v1->data();
+                                       T* vec2 = vop.result->data();
+                                 const T  v    = *inst.a;
+                                 const std::size_t n = vop.result->size();
+
+                                 for (std::size_t i = 0; i < n; ++i)
+                                 {
+                                    vec2[i] = vop.bf(v, vec1[i]);
+                                 }
+
+                                 *inst.r = vec2[0];
+                              }
+                              break;
+
+            case e_vecunary : {
+                                 const vector_operation& vop = *inst.vop;
+                                 const T* vec0 = vop.v0->data();
+                                       T* vec1 = vop.result->data();
+                                 const std::size_t n = vop.result->size();
+
+                                 if (vop.kernel)
+                                    vector_kernels<T>::run(vop.kernel, vec0, vec1, n);
+                                 else
+                                 {
+                                    for (std::size_t i = 0; i < n; ++i)
+                                    {
+                                       vec1[i] = vop.uf(vec0[i]);
+                                    }
+                                 }
+
+                                 *inst.r = vec1[0];
+                              }
+                              break;
+
+            default         : break;
+         }
+      }
+
+      template<typename T> bool bytecode_program<T>::value_batch(const bytecode_column<T>* column_list, const std::size_t column_count,
+                                                                 T* result, const std::size_t rows, const std::size_t block_size,
+                                                                 const bool vector_math) const
+      {
+         if (0 == block_size)
+            return false;
+
+         const std::size_t no_operand = static_cast<std::size_t>(-1);
+         const std::size_t count      = instruction_list_.size() - 1;
+
+         batch_operand_map_t      operand_map;
+         batch_operand_list_t     operand_list;
+         std::vector<std::size_t> operand_index(count * 5, no_operand);
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            const instruction& inst = instruction_list_[i];
+            std::size_t* index = &operand_index[i * 5];
+
+            switch (inst.op)
+            {
+               case e_mov    :
+               case e_neg    :
+               case e_ufunc  : index[1] = batch_operand_index(inst.a, operand_map, operand_list);
+                               break;
+
+               case e_add    :
+               case e_sub    :
+               case e_mul    :
+               case e_div    :
+               case e_bfunc  : index[1] = batch_operand_index(inst.a, operand_map, operand_list);
+                               index[2] = batch_operand_index(inst.b, operand_map, operand_list);
+                               break;
+
+               case e_qfunc  : index[4] = batch_operand_index(inst.qop->d, operand_map, operand_list);
+                               index[1] = batch_operand_index(inst.a, operand_map, operand_list);
+                               index[2] = batch_operand_index(inst.b, operand_map, operand_list);
+                               index[3] = batch_operand_index(inst.c, operand_map, operand_list);
+                               break;
+
+               case e_tfunc  :
+               case e_select : index[1] = batch_operand_index(inst.a, operand_map, operand_list);
+                               index[2] = batch_operand_index(inst.b, operand_map, operand_list);
+                               index[3] = batch_operand_index(inst.c, operand_map, operand_list);
+                               break;
+
+               default       : return false;
+            }
+
+            for (std::size_t j = 1; j < 5; ++j)
+            {
+               if (no_operand != index[j])
+                  operand_list[index[j]].read = true;
+            }
+
+            index[0] = batch_operand_index(inst.r, operand_map, operand_list);
+
+            batch_operand& r = operand_list[index[0]];
+
+            // A value read before it is written carries state from one row
+            // to the next, rows are then not independent.
+            if (r.read && !r.written)
+               return false;
+
+            r.written = true;
+         }
+
+         const std::size_t result_index = batch_operand_index(result_, operand_map, operand_list);
+
+         for (std::size_t i = 0; i < column_count; ++i)
+         {
+            const typename batch_operand_map_t::const_iterator itr = operand_map.find(column_list[i].variable);
+
+            if (operand_map.end() == itr)
+               continue;
+            else if (operand_list[itr->second].written)
+               return false;
+
+            operand_list[itr->second].column = column_list[i].data;
+         }
+
+         std::size_t buffer_count = 0;
+
+         for (std::size_t i = 0; i < operand_list.size(); ++i)
+         {
+            if (0 == operand_list[i].column)
+               ++buffer_count;
+         }
+
+         std::vector<T> storage(buffer_count * block_size);
+         T* buffer = storage.empty() ? 0 : &storage[0];
+
+         for (std::size_t i = 0; i < operand_list.size(); ++i)
+         {
+            batch_operand& operand = operand_list[i];
+
+            if (operand.column)
+               continue;
+
+            operand.base = buffer;
+            buffer += block_size;
+
+            if (!operand.written)
+               std::fill_n(operand.base, block_size, *operand.address);
+         }
+
+         typedef vector_kernels<T> kernels_t;
+
+         std::vector<kernel_t> ufunc_kernel(count, kernel_t(0));
+
+         if (vector_math)
+         {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+               if (e_ufunc == instruction_list_[i].op)
+                  ufunc_kernel[i] = details::vector_math<T>::unary(instruction_list_[i].uf);
+            }
+         }
+
+         const typename kernels_t::vecvec_t add_kernel = kernels_t::vecvec(details::e_add);
+         const typename kernels_t::vecvec_t sub_kernel = kernels_t::vecvec(details::e_sub);
+         const typename kernels_t::vecvec_t mul_kernel = kernels_t::vecvec(details::e_mul);
+         const typename kernels_t::vecvec_t div_kernel = kernels_t::vecvec(details::e_div);
+         const typename kernels_t::unary_t  neg_kernel = kernels_t::unary (details::e_neg);
+
+         std::size_t n = 0;
+
+         for (std::size_t start = 0; start < rows; start += n)
+         {
+            n = std::min(block_size, rows - start);
+
+            for (std::size_t i = 0; i < operand_list.size(); ++i)
+            {
+               if (operand_list[i].column)
+                  operand_list[i].base = const_cast<T*>(operand_list[i].column) + start;
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+               const instruction& inst  = instruction_list_[i];
+               const std::size_t* index = &operand_index[i * 5];
+
+               T* const r = operand_list[index[0]].base;
+               const T* const a = (no_operand != index[1]) ? operand_list[index[1]].base : 0;
+               const T* const b = (no_operand != index[2]) ? operand_list[index[2]].base : 0;
+               const T* const c = (no_operand != index[3]) ? operand_list[index[3]].base : 0;
+
+               switch (inst.op)
+               {
+                  case e_mov    : std::copy(a, a + n, r);
+                                  break;
+
+                  case e_add    : if (add_kernel)
+                                     add_kernel(a, b, r, n);
+                                  else
+                                     for (std::size_t j = 0; j < n; ++j) r[j] = a[j] + b[j];
+                                  break;
+
+                  case e_sub    : if (sub_kernel)
+                                     sub_kernel(a, b, r, n);
+                                  else
+                                     for (std::size_t j = 0; j < n; ++j) r[j] = a[j] - b[j];
+                                  break;
+
+                  case e_mul    : if (mul_kernel)
+                                     mul_kernel(a, b, r, n);
+                                  else
+                                     for (std::size_t j = 0; j < n; ++j) r[j] = a[j] * b[j];
+                                  break;
+
+                  case e_div    : if (div_kernel)
+                                     div_kernel(a, b, r, n);
+                                  else
+                                     for (std::size_t j = 0; j < n; ++j) r[j] = a[j] / b[j];
+                                  break;
+
+                  case e_neg    : if (neg_kernel)
+                                     neg_kernel(a, r, n);
+                                  else
+                                     for (std::size_t j = 0; j < n; ++j) r[j] = -a[j];
+                                  break;
+
+                  case e_ufunc  : if (ufunc_kernel[i])
+                                     ufunc_kernel[i](a, r, n);
+                                  else
+                                     for (std::size_t j = 0; j < n; ++j) r[j] = inst.uf(a[j]);
+                                  break;
+
+                  case e_bfunc  : for (std::size_t j = 0; j < n; ++j) r[j] = inst.bf(a[j], b[j]);
+                                  break;
+
+                  case e_tfunc  : for (std::size_t j = 0; j < n; ++j) r[j] = inst.tf(a[j], b[j], c[j]);
+                                  break;
+
+                  case e_qfunc  : {
+                                     const T* const d = operand_list[index[4]].base;
+
+                                     for (std::size_t j = 0; j < n; ++j) r[j] = inst.qop->qf(a[j], b[j], c[j], d[j]);
+                                  }
+                                  break;
+
+                  case e_select : for (std::size_t j = 0; j < n; ++j) r[j] = is_true(a[j]) ? b[j] : c[j];
+                                  break;
+
+                  default       : break;
+               }
+            }
+
+            std::copy(operand_list[result_index].base, operand_list[result_index].base + n, result + start);
+         }
+
+         // Leave written memory, such as local variables, holding the
+         // value of the last row as a row by row evaluation would.
+         if (n)
+         {
+            for (std::size_t i = 0; i < operand_list.size(); ++i)
+            {
+               if (operand_list[i].written)
+                  *const_cast<T*>(operand_list[i].address) = operand_list[i].base[n - 1];
+            }
+         }
+
+         return true;
+      }
+
+      template<typename T> std::size_t bytecode_program<T>::batch_operand_index(const T* address,
+                                                                                batch_operand_map_t& operand_map,
+                                                                                batch_operand_list_t& operand_list)
+      {
+         const typename batch_operand_map_t::const_iterator itr = operand_map.find(address);
+
+         if (operand_map.end() != itr)
+            return itr->second;
+
+         batch_operand operand;
+         operand.address = address;
+         operand.column  = 0;
+         operand.base    = 0;
+         operand.read    = false;
+         operand.written = false;
+
+         operand_list.push_back(operand);
+         operand_map[address] = operand_list.size() - 1;
+
+         return operand_list.size() - 1;
+      }
+
+      template<typename T> bool bytecode_program<T>::key(std::string& key, std::vector<const T*>& read_list,
+                                                         std::vector<const T*>& write_list, std::size_t& cost) const
+      {
+         key.clear();
+         read_list.clear();
+         write_list.clear();
+         cost = 0;
+
+         const T* const registers = register_list_.empty() ? 0 : &register_list_[0];
+
+         std::vector<bool> written(register_list_.size(), false);
+
+         for (std::size_t i = 0; i < instruction_list_.size(); ++i)
+         {
+            const T* const r = instruction_list_[i].r;
+
+            if (r && (r >= registers) && (r < registers + register_list_.size()))
+               written[r - registers] = true;
+         }
+
+         for (std::size_t i = 0; i < instruction_list_.size(); ++i)
+         {
+            const instruction& inst = instruction_list_[i];
+
+            key_bytes(key, inst.op);
+
+            switch (inst.op)
+            {
+               case e_halt       : continue;
+
+               case e_call       :
+               case e_vecvec     :
+               case e_vecval     :
+               case e_valvec     :
+               case e_vecunary   : return false;
+
+               case e_ufunc      : key_bytes(key, inst.uf);
+                                   ++cost;
+                                   break;
+
+               case e_bfunc      : key_bytes(key, inst.bf);
+                                   ++cost;
+                                   break;
+
+               case e_tfunc      : key_bytes(key, inst.tf);
+                                   break;
+
+               case e_qfunc      : key_bytes(key, inst.qop->qf);
+                                   key_operand(key, inst.qop->d, written, read_list);
+                                   break;
+
+               case e_function   : if (inst.fop->function->has_side_effects())
+                                      return false;
+
+                                   key_bytes(key, inst.fop->function);
+                                   key_bytes(key, inst.fop->invoke);
+
+                                   for (std::size_t j = 0; j < inst.fop->argument_list.size(); ++j)
+                                   {
+                                      key_operand(key, inst.fop->argument_list[j], written, read_list);
+                                   }
+
+                                   ++cost;
+                                   break;
+
+               case e_jump       :
+               case e_jump_false : key_bytes(key, inst.target);
+                                   break;
+
+               default           : break;
+            }
+
+            key_operand(key, inst.r, written, write_list);
+            key_operand(key, inst.a, written, read_list);
+            key_operand(key, inst.b, written, read_list);
+            key_operand(key, inst.c, written, read_list);
+
+            ++cost;
+         }
+
+         key_operand(key, result_, written, read_list);
+
+         return true;
+      }
+
+      template<typename T> void bytecode_program<T>::key_operand(std::string& key, const T* address,
+                                                                 const std::vector<bool>& written,
+                                                                 std::vector<const T*>& address_list) const
+      {
+         const T* const registers = register_list_.empty() ? 0 : &register_list_[0];
+
+         if (0 == address)
+            key += 'n';
+         else if ((address >= registers) && (address < registers + register_list_.size()))
+         {
+            const std::size_t index = address - registers;
+
+            if (written[index])
+            {
+               key += 'r';
+               key_bytes(key, index);
+            }
+            else
+            {
+               key += 'k';
+               key_bytes(key, *address);
+            }
+         }
+         else
+         {
+            key += 'm';
+            key_bytes(key, address);
+            address_list.push_back(address);
+         }
+      }
+
+      template<typename T> template <typename Type> void bytecode_program<T>::key_bytes(std::string& key, const Type& value)
+      {
+         key.append(reinterpret_cast<const char*>(&value), sizeof(Type));
+      }
+
+      template<typename T> std::size_t bytecode_program<T>::size() const
+      {
+         return instruction_list_.size();
+      }
+
+      template<typename T> std::size_t bytecode_program<T>::register_count() const
+      {
+         return register_list_.size();
+      }
+
+      template<typename T> std::size_t bytecode_program<T>::call_count() const
+      {
+         return call_count_;
+      }
+
+      template<typename T> bytecode_builder<T>::bytecode_builder(program_t& program, const bool branch_free, const bool share_values)
+      : program_(program)
+      , side_effects_(0)
+      , branch_free_(branch_free)
+      , share_values_(share_values)
+      {}
+
+      template<typename T> bool bytecode_builder<T>::build(const expression_node<T>* root)
+      {
+         operand_t result = no_operand;
+
+         if ((0 == root) || !root->lower(*this, result))
+            return false;
+
+         finalise(result);
+
+         return true;
+      }
+
+      template<typename T> bool bytecode_builder<T>::build(const expression_node<T>* const* root, T* result, const std::size_t count)
+      {
+         if (0 == count)
+            return false;
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            if (0 == root[i])
+               return false;
+         }
+
+         operand_t last = no_operand;
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            last = move(reference(result[i]), lower(root[i]));
+         }
+
+         finalise(last);
+
+         return true;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::lower(const expression_node<T>* node)
+      {
+         const mark_t m = mark();
+
+         operand_t result = no_operand;
+
+         if (node->lower(*this, result))
+            return result;
+
+         rollback(m);
+
+         result = temporary();
+
+         const std::size_t index = emit(program_t::e_call, result);
+         pending_list_[index].inst.node = node;
+         ++side_effects_;
+         forget_values();
+
+         return result;
+      }
+
+      template<typename T> void bytecode_builder<T>::lower(const expression_node<T>* const* branch, operand_t* result, const std::size_t count)
+      {
+         const mark_t start = mark();
+
+         std::vector<std::size_t> side_effects(count);
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            if (branch[i])
+               result[i] = lower(branch[i]);
+
+            side_effects[i] = side_effects_;
+         }
+
+         std::vector<bool> pin(count, false);
+         bool pinned = false;
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            if (is_reference(result[i]) && (side_effects[i] != side_effects_))
+            {
+               pin[i] = true;
+               pinned = true;
+            }
+         }
+
+         if (!pinned)
+            return;
+
+         rollback(start);
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            if (branch[i])
+               result[i] = lower(branch[i]);
+
+            if (pin[i])
+               result[i] = copy(result[i]);
+         }
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::constant(const T& value)
+      {
+         if (!share_values_)
+            return new_slot(0, value);
+
+         const std::string bytes(reinterpret_cast<const char*>(&value), sizeof(T));
+         const typename constant_map_t::const_iterator itr = constant_map_.find(bytes);
+
+         if (constant_map_.end() != itr)
+            return itr->second;
+
+         return constant_map_[bytes] = new_slot(0, value);
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::reference(const T& value)
+      {
+         return new_slot(const_cast<T*>(&value), T(0));
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::temporary()
+      {
+         return new_slot(0, T(0));
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::copy(const operand_t source)
+      {
+         return move(temporary(), source);
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::move(const operand_t destination, const operand_t source)
+      {
+         emit(program_t::e_mov, destination, source);
+         return destination;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::unary(ufunc_t f, const operand_t a, const operand_t result)
+      {
+         const value_key_t key = (no_operand == result) ?
+                                 value_key(program_t::e_ufunc, reinterpret_cast<std::uintptr_t>(f), &a, 1) :
+                                 value_key_t();
+
+         operand_t r = no_operand;
+
+         if (find_value(key, r))
+            return r;
+
+         r = (no_operand == result) ? temporary() : result;
+
+         if (static_cast<ufunc_t>(&neg_op<T>::process) == f)
+            emit(program_t::e_neg, r, a);
+         else
+            pending_list_[emit(program_t::e_ufunc, r, a)].inst.uf = f;
+
+         remember_value(key, r);
+
+         return r;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::binary(bfunc_t f, const operand_t a, const operand_t b, const operand_t result)
+      {
+         const operand_t operand[] = { a, b };
+
+         const value_key_t key = (no_operand == result) ?
+                                 value_key(program_t::e_bfunc, reinterpret_cast<std::uintptr_t>(f), operand, 2) :
+                                 value_key_t();
+
+         operand_t r = no_operand;
+
+         if (find_value(key, r))
+            return r;
+
+         r = (no_operand == result) ? temporary() : result;
+
+         if      (static_cast<bfunc_t>(&add_op<T>::process) == f) emit(program_t::e_add, r, a, b);
+         else if (static_cast<bfunc_t>(&sub_op<T>::process) == f) emit(program_t::e_sub, r, a, b);
+         else if (static_cast<bfunc_t>(&mul_op<T>::process) == f) emit(program_t::e_mul, r, a, b);
+         else if (static_cast<bfunc_t>(&div_op<T>::process) == f) emit(program_t::e_div, r, a, b);
+         else
+            pending_list_[emit(program_t::e_bfunc, r, a, b)].inst.bf = f;
+
+         remember_value(key, r);
+
+         return r;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::trinary(tfunc_t f, const operand_t a, const operand_t b, const operand_t c)
+      {
+         const operand_t operand[] = { a, b, c };
+         const value_key_t key = value_key(program_t::e_tfunc, reinterpret_cast<std::uintptr_t>(f), operand, 3);
+
+         operand_t r = no_operand;
+
+         if (find_value(key, r))
+            return r;
+
+         r = temporary();
+         pending_list_[emit(program_t::e_tfunc, r, a, b, c)].inst.tf = f;
+         remember_value(key, r);
+         return r;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::quaternary(qfunc_t f, const operand_t a, const operand_t b, const operand_t c, const operand_t d)
+      {
+         const operand_t operand[] = { a, b, c, d };
+         const value_key_t key = value_key(program_t::e_qfunc, reinterpret_cast<std::uintptr_t>(f), operand, 4);
+
+         operand_t r = no_operand;
+
+         if (find_value(key, r))
+            return r;
+
+         typename program_t::quaternary_operation qop;
+         qop.qf = f;
+         qop.d  = 0;
+         program_.quaternary_operation_list_.push_back(qop);
+
+         r = temporary();
+         const std::size_t index = emit(program_t::e_qfunc, r, a, b, c);
+         pending_list_[index].inst.qop = &program_.quaternary_operation_list_.back();
+         pending_list_[index].d        = d;
+         remember_value(key, r);
+         return r;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::vector_vecvec(bfunc_t f, const vds_t& v0, const vds_t& v1, const vds_t& result)
+      {
+         typename program_t::vector_operation vop;
+         vop.bf     = f;
+         vop.uf     = 0;
+         vop.kernel = 0;
+         vop.v0     = &v0;
+         vop.v1     = &v1;
+         vop.result = &result;
+         program_.vector_operation_list_.push_back(vop);
+
+         const operand_t r = temporary();
+         pending_list_[emit(program_t::e_vecvec, r)].inst.vop = &program_.vector_operation_list_.back();
+         ++side_effects_;
+         forget_values();
+         return r;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::vector_vecval(bfunc_t f, const vds_t& v0, const operand_t b, const vds_t& result)
+      {
+         typename program_t::vector_operation vop;
+         vop.bf     = f;
+         vop.uf     = 0;
+         vop.kernel = 0;
+         vop.v0     = &v0;
+         vop.v1     = 0;
+         vop.result = &result;
+         program_.vector_operation_list_.push_back(vop);
+
+         const operand_t r = temporary();
+         pending_list_[emit(program_t::e_vecval, r, no_operand, b)].inst.vop = &program_.vector_operation_list_.back();
+         ++side_effects_;
+         forget_values();
+         return r;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::vector_valvec(bfunc_t f, const operand_t a, const vds_t& v1, const vds_t& result)
+      {
+         typename program_t::vector_operation vop;
+         vop.bf     = f;
+         vop.uf     = 0;
+         vop.kernel = 0;
+         vop.v0     = 0;
+         vop.v1     = &v1;
+         vop.result = &result;
+         program_.vector_operation_list_.push_back(vop);
+
+         const operand_t r = temporary();
+         pending_list_[emit(program_t::e_valvec, r, a)].inst.vop = &program_.vector_operation_list_.back();
+         ++side_effects_;
+         forget_values();
+         return r;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::vector_unary(ufunc_t f, const vds_t& v0, const vds_t& result, kernel_t kernel)
+      {
+         typename program_t::vector_operation vop;
+         vop.bf     = 0;
+         vop.uf     = f;
+         vop.kernel = kernel;
+         vop.v0     = &v0;
+         vop.v1     = 0;
+         vop.result = &result;
+         program_.vector_operation_list_.push_back(vop);
+
+         const operand_t r = temporary();
+         pending_list_[emit(program_t::e_vecunary, r)].inst.vop = &program_.vector_operation_list_.back();
+         ++side_effects_;
+         forget_values();
+         return r;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::select(const operand_t condition, const operand_t consequent, const operand_t alternative)
+      {
+         const operand_t operand[] = { condition, consequent, alternative };
+         const value_key_t key = value_key(program_t::e_select, 0, operand, 3);
+
+         operand_t r = no_operand;
+
+         if (find_value(key, r))
+            return r;
+
+         r = temporary();
+         emit(program_t::e_select, r, condition, consequent, alternative);
+         remember_value(key, r);
+         return r;
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::function(ifunction<T>* f, invoke_t invoke, const operand_t* argument, const std::size_t count)
+      {
+         const value_key_t key = f->has_side_effects() ?
+                                 value_key_t() :
+                                 value_key(program_t::e_function, reinterpret_cast<std::uintptr_t>(f), argument, count);
+
+         operand_t r = no_operand;
+
+         if (find_value(key, r))
+            return r;
+
+         typename program_t::function_operation fop;
+         fop.function = f;
+         fop.invoke   = invoke;
+         program_.function_operation_list_.push_back(fop);
+
+         r = temporary();
+         const std::size_t index = emit(program_t::e_function, r);
+         pending_list_[index].inst.fop = &program_.function_operation_list_.back();
+         pending_list_[index].argument_list.assign(argument, argument + count);
+         ++side_effects_;
+
+         if (f->has_side_effects())
+            forget_values();
+         else
+            remember_value(key, r);
+
+         return r;
+      }
+
+      template<typename T> bool bytecode_builder<T>::branch_free() const
+      {
+         return branch_free_;
+      }
+
+      template<typename T> bool bytecode_builder<T>::shares_values() const
+      {
+         return share_values_;
+      }
+
+      template<typename T> std::size_t bytecode_builder<T>::side_effects() const
+      {
+         return side_effects_;
+      }
+
+      template<typename T> std::size_t bytecode_builder<T>::position()
+      {
+         forget_values();
+         return pending_list_.size();
+      }
+
+      template<typename T> std::size_t bytecode_builder<T>::jump(const std::size_t target)
+      {
+         const std::size_t index = emit(program_t::e_jump);
+         pending_list_[index].inst.target = target;
+         forget_values();
+         return index;
+      }
+
+      template<typename T> std::size_t bytecode_builder<T>::jump_false(const operand_t condition, const std::size_t target)
+      {
+         const std::size_t index = emit(program_t::e_jump_false, no_operand, condition);
+         pending_list_[index].inst.target = target;
+         forget_values();
+         return index;
+      }
+
+      template<typename T> void bytecode_builder<T>::patch(const std::size_t jump_position, const std::size_t target)
+      {
+         pending_list_[jump_position].inst.target = target;
+      }
+
+      template<typename T> typename bytecode_builder<T>::mark_t bytecode_builder<T>::mark() const
+      {
+         mark_t m;
+         m.instructions = pending_list_.size();
+         m.side_effects = side_effects_;
+         return m;
+      }
+
+      template<typename T> void bytecode_builder<T>::rollback(const mark_t& m)
+      {
+         pending_list_.resize(m.instructions);
+         side_effects_ = m.side_effects;
+         forget_values();
+      }
+
+      template<typename T> bool bytecode_builder<T>::is_reference(const operand_t operand) const
+      {
+         return (no_operand != operand) && (0 != slot_list_[operand].external);
+      }
+
+      template<typename T> typename bytecode_builder<T>::operand_t bytecode_builder<T>::new_slot(T* external, const T& value)
+      {
+         slot s;
+         s.external = external;
+         s.value    = value;
+         s.shared   = false;
+         slot_list_.push_back(s);
+
+         return slot_list_.size() - 1;
+      }
+
+      template<typename T> typename bytecode_builder<T>::value_key_t bytecode_builder<T>::value_key(const opcode_t op, const std::uintptr_t function,
+                                                                                                     const operand_t* operand, const std::size_t count)
+      {
+         value_key_t key;
+
+         if (!share_values_)
+            return key;
+
+         key.reserve(count + 2);
+         key.push_back(static_cast<std::uintptr_t>(op));
+         key.push_back(function);
+
+         // Addresses of T are even, slots are told apart by an odd value.
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            if (no_operand == operand[i])
+               key.push_back(0);
+            else if (is_reference(operand[i]))
+               key.push_back(reinterpret_cast<std::uintptr_t>(slot_list_[operand[i]].external));
+            else
+            {
+               key.push_back((static_cast<std::uintptr_t>(operand[i]) << 1) | 1);
+               slot_list_[operand[i]].shared = true;
+            }
+         }
+
+         return key;
+      }
+
+      template<typename T> bool bytecode_builder<T>::find_value(const value_key_t& key, operand_t& result) const
+      {
+         if (key.empty())
+            return false;
+
+         const typename value_map_t::const_iterator itr = value_map_.find(key);
+
+         if (value_map_.end() == itr)
+            return false;
+
+         result = itr->second;
+
+         return true;
+      }
+
+      template<typename T> void bytecode_builder<T>::remember_value(const value_key_t& key, const operand_t result)
+      {
+         if (key.empty())
+            return;
+
+         value_map_[key] = result;
+         slot_list_[result].shared = true;
+      }
+
+      template<typename T> void bytecode_builder<T>::forget_value(const operand_t operand)
+      {
+         if (value_map_.empty() || (no_operand == operand))
+            return;
+
+         std::uintptr_t id = 0;
+
+         if (is_reference(operand))
+            id = reinterpret_cast<std::uintptr_t>(slot_list_[operand].external);
+         else if (slot_list_[operand].shared)
+            id = (static_cast<std::uintptr_t>(operand) << 1) | 1;
+         else
+            return;
+
+         typename value_map_t::iterator itr = value_map_.begin();
+
+         while (value_map_.end() != itr)
+         {
+            if (
+                 (operand == itr->second) ||
+                 (itr->first.end() != std::find(itr->first.begin() + 2, itr->first.end(), id))
+               )
+               value_map_.erase(itr++);
+            else
+               ++itr;
+         }
+      }
+
+      template<typename T> void bytecode_builder<T>::forget_values()
+      {
+         value_map_.clear();
+      }
+
+      template<typename T> std::size_t bytecode_builder<T>::emit(const opcode_t op,
+                                                                 const operand_t r,
+                                                                 const operand_t a,
+                                                                 const operand_t b,
+                                                                 const operand_t c)
+      {
+         pending_instruction p;
+         p.inst.op     = op;
+         p.inst.r      = 0;
+         p.inst.a      = 0;
+         p.inst.b      = 0;
+         p.inst.c      = 0;
+         p.inst.target = 0;
+         p.r           = r;
+         p.a           = a;
+         p.b           = b;
+         p.c           = c;
+         p.d           = no_operand;
+
+         if (is_reference(r))
+            ++side_effects_;
+
+         forget_value(r);
+
+         pending_list_.push_back(p);
+
+         return pending_list_.size() - 1;
+      }
+
+      template<typename T> void bytecode_builder<T>::finalise(const operand_t result)
+      {
+         std::vector<std::size_t> register_index(slot_list_.size(), 0);
+         std::size_t register_count = 0;
+
+         for (std::size_t i = 0; i < slot_list_.size(); ++i)
+         {
+            if (0 == slot_list_[i].external)
+               register_index[i] = register_count++;
+         }
+
+         program_.register_list_.assign(register_count, T(0));
+
+         for (std::size_t i = 0; i < slot_list_.size(); ++i)
+         {
+            if (0 == slot_list_[i].external)
+               program_.register_list_[register_index[i]] = slot_list_[i].value;
+         }
+
+         T* const registers = program_.register_list_.empty() ? 0 : &program_.register_list_[0];
+
+         #define resolve_operand(operand)                        \
+         ((no_operand == (operand)) ? 0 :                        \
+          (slot_list_[(operand)].external ?                      \
+           slot_list_[(operand)].external :                      \
+           registers + register_index[(operand)]))               \
+
+         program_.instruction_list_.clear();
+         program_.instruction_list_.reserve(pending_list_.size() + 1);
+         program_.call_count_ = 0;
+
+         for (std::size_t i = 0; i < pending_list_.size(); ++i)
+         {
+            instruction_t inst = pending_list_[i].inst;
+
+            inst.r = resolve_operand(pending_list_[i].r);
+            inst.a = resolve_operand(pending_list_[i].a);
+            inst.b = resolve_operand(pending_list_[i].b);
+            inst.c = resolve_operand(pending_list_[i].c);
+
+            if (program_t::e_qfunc == inst.op)
+               const_cast<typename program_t::quaternary_operation*>(inst.qop)->d = resolve_operand(pending_list_[i].d);
+            else if (program_t::e_function == inst.op)
+            {
+               typename program_t::function_operation& fop = const_cast<typename program_t::function_operation&>(*inst.fop);
+               fop.argument_list.clear();
+
+               for (std::size_t j = 0; j < pending_list_[i].argument_list.size(); ++j)
+               {
+                  fop.argument_list.push_back(resolve_operand(pending_list_[i].argument_list[j]));
+               }
+            }
+            else if (program_t::e_call == inst.op)
+               ++program_.call_count_;
+
+            program_.instruction_list_.push_back(inst);
+         }
+
+         instruction_t halt = instruction_t();
+         halt.op = program_t::e_halt;
+         program_.instruction_list_.push_back(halt);
+
+         program_.result_ = resolve_operand(result);
+
+         #undef resolve_operand
+      }
+
+      template class bytecode_program<int16_t>;
+      template class bytecode_program<int32_t>;
+      template class bytecode_program<int64_t>;
+      template class bytecode_program<float>;
+      template class bytecode_program<double>;
+      template class bytecode_program<long double>;
+      template class bytecode_program<std::complex<float>>;
+      template class bytecode_program<std::complex<double>>;
+      template class bytecode_program<std::complex<long double>>;
+
+      template class bytecode_builder<int16_t>;
+      template class bytecode_builder<int32_t>;
+      template class bytecode_builder<int64_t>;
+      template class bytecode_builder<float>;
+      template class bytecode_builder<double>;
+      template class bytecode_builder<long double>;
+      template class bytecode_builder<std::complex<float>>;
+      template class bytecode_builder<std::complex<double>>;
+      template class bytecode_builder<std::complex<long double>>;
+   }
+}
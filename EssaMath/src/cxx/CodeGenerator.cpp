@@ -0,0 +1,639 @@
+#include "include/CodeGenerator.hpp"
+#include "include/Operators.hpp"
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace Essa::Math{
+   namespace details
+   {
+      template<typename T> cpp_generator<T>::cpp_generator()
+      : type_(type_name(T()))
+      , register_begin_(0)
+      , register_end_(0)
+      {
+         #define register_unary_op(op)                                          \
+         unary_name_map_[static_cast<ufunc_t>(&op##_op<T>::process)] = op_name(#op "_op"); \
+
+         register_unary_op(abs  ) register_unary_op(acos ) register_unary_op(acosh)
+         register_unary_op(asin ) register_unary_op(asinh) register_unary_op(atan )
+         register_unary_op(atanh) register_unary_op(ceil ) register_unary_op(cos  )
+         register_unary_op(cosh ) register_unary_op(cot  ) register_unary_op(csc  )
+         register_unary_op(d2g  ) register_unary_op(d2r  ) register_unary_op(erf  )
+         register_unary_op(erfc ) register_unary_op(exp  ) register_unary_op(expm1)
+         register_unary_op(floor) register_unary_op(frac ) register_unary_op(g2d  )
+         register_unary_op(log  ) register_unary_op(log10) register_unary_op(log2 )
+         register_unary_op(log1p) register_unary_op(ncdf ) register_unary_op(neg  )
+         register_unary_op(notl ) register_unary_op(pos  ) register_unary_op(r2d  )
+         register_unary_op(round) register_unary_op(sec  ) register_unary_op(sgn  )
+         register_unary_op(sin  ) register_unary_op(sinc ) register_unary_op(sinh )
+         register_unary_op(sqrt ) register_unary_op(tan  ) register_unary_op(tanh )
+         register_unary_op(trunc)
+         #undef register_unary_op
+
+         #define register_binary_op(op)                                    \
+         binary_name_map_[static_cast<bfunc_t>(&op<T>::process)] = op_name(#op); \
+
+         register_binary_op(add_op ) register_binary_op(sub_op ) register_binary_op(mul_op  )
+         register_binary_op(div_op ) register_binary_op(mod_op ) register_binary_op(pow_op  )
+         register_binary_op(lt_op  ) register_binary_op(lte_op ) register_binary_op(gt_op   )
+         register_binary_op(gte_op ) register_binary_op(eq_op  ) register_binary_op(equal_op)
+         register_binary_op(ne_op  ) register_binary_op(and_op ) register_binary_op(nand_op )
+         register_binary_op(or_op  ) register_binary_op(nor_op ) register_binary_op(xor_op  )
+         register_binary_op(xnor_op)
+         #undef register_binary_op
+
+         #define register_sf3_op(NN)                                            \
+         trinary_name_map_[&sf##NN##_op<T>::process] = op_name("sf" #NN "_op"); \
+
+         register_sf3_op(00) register_sf3_op(01) register_sf3_op(02) register_sf3_op(03)
+         register_sf3_op(04) register_sf3_op(05) register_sf3_op(06) register_sf3_op(07)
+         register_sf3_op(08) register_sf3_op(09) register_sf3_op(10) register_sf3_op(11)
+         register_sf3_op(12) register_sf3_op(13) register_sf3_op(14) register_sf3_op(15)
+         register_sf3_op(16) register_sf3_op(17) register_sf3_op(18) register_sf3_op(19)
+         register_sf3_op(20) register_sf3_op(21) register_sf3_op(22) register_sf3_op(23)
+         register_sf3_op(24) register_sf3_op(25) register_sf3_op(26) register_sf3_op(27)
+         register_sf3_op(28) register_sf3_op(29) register_sf3_op(30) register_sf3_op(31)
+         register_sf3_op(32) register_sf3_op(33) register_sf3_op(34) register_sf3_op(35)
+         register_sf3_op(36) register_sf3_op(37) register_sf3_op(38) register_sf3_op(39)
+         register_sf3_op(40) register_sf3_op(41) register_sf3_op(42) register_sf3_op(43)
+         register_sf3_op(44) register_sf3_op(45) register_sf3_op(46) register_sf3_op(47)
+         #undef register_sf3_op
+
+         #define register_sf4_op(NN)                                               \
+         quaternary_name_map_[&sf##NN##_op<T>::process] = op_name("sf" #NN "_op"); \
+
+         register_sf4_op(48) register_sf4_op(49) register_sf4_op(50) register_sf4_op(51)
+         register_sf4_op(52) register_sf4_op(53) register_sf4_op(54) register_sf4_op(55)
+         register_sf4_op(56) register_sf4_op(57) register_sf4_op(58) register_sf4_op(59)
+         register_sf4_op(60) register_sf4_op(61) register_sf4_op(62) register_sf4_op(63)
+         register_sf4_op(64) register_sf4_op(65) register_sf4_op(66) register_sf4_op(67)
+         register_sf4_op(68) register_sf4_op(69) register_sf4_op(70) register_sf4_op(71)
+         register_sf4_op(72) register_sf4_op(73) register_sf4_op(74) register_sf4_op(75)
+         register_sf4_op(76) register_sf4_op(77) register_sf4_op(78) register_sf4_op(79)
+         register_sf4_op(80) register_sf4_op(81) register_sf4_op(82) register_sf4_op(83)
+         register_sf4_op(84) register_sf4_op(85) register_sf4_op(86) register_sf4_op(87)
+         register_sf4_op(88) register_sf4_op(89) register_sf4_op(90) register_sf4_op(91)
+         register_sf4_op(92) register_sf4_op(93) register_sf4_op(94) register_sf4_op(95)
+         register_sf4_op(96) register_sf4_op(97) register_sf4_op(98) register_sf4_op(99)
+
+         register_sf4_op(ext00) register_sf4_op(ext01) register_sf4_op(ext02) register_sf4_op(ext03)
+         register_sf4_op(ext04) register_sf4_op(ext05) register_sf4_op(ext06) register_sf4_op(ext07)
+         register_sf4_op(ext08) register_sf4_op(ext09) register_sf4_op(ext10) register_sf4_op(ext11)
+         register_sf4_op(ext12) register_sf4_op(ext13) register_sf4_op(ext14) register_sf4_op(ext15)
+         register_sf4_op(ext16) register_sf4_op(ext17) register_sf4_op(ext18) register_sf4_op(ext19)
+         register_sf4_op(ext20) register_sf4_op(ext21) register_sf4_op(ext22) register_sf4_op(ext23)
+         register_sf4_op(ext24) register_sf4_op(ext25) register_sf4_op(ext26) register_sf4_op(ext27)
+         register_sf4_op(ext28) register_sf4_op(ext29) register_sf4_op(ext30) register_sf4_op(ext31)
+         register_sf4_op(ext32) register_sf4_op(ext33) register_sf4_op(ext34) register_sf4_op(ext35)
+         register_sf4_op(ext36) register_sf4_op(ext37) register_sf4_op(ext38) register_sf4_op(ext39)
+         register_sf4_op(ext40) register_sf4_op(ext41) register_sf4_op(ext42) register_sf4_op(ext43)
+         register_sf4_op(ext44) register_sf4_op(ext45) register_sf4_op(ext46) register_sf4_op(ext47)
+         register_sf4_op(ext48) register_sf4_op(ext49) register_sf4_op(ext50) register_sf4_op(ext51)
+         register_sf4_op(ext52) register_sf4_op(ext53) register_sf4_op(ext54) register_sf4_op(ext55)
+         register_sf4_op(ext56) register_sf4_op(ext57) register_sf4_op(ext58) register_sf4_op(ext59)
+         register_sf4_op(ext60) register_sf4_op(ext61)
+         #undef register_sf4_op
+
+         // The powers expression_generator::cardinal_pow_optimisation()
+         // turns into ipow nodes.
+         #define register_ipow(n)                                                                          \
+         unary_name_map_[&ipow_function<T,numeric::fast_exp<T,n> >::process] = ipow_name(#n, "process"); \
+         unary_name_map_[&ipow_function<T,numeric::fast_exp<T,n> >::inverse] = ipow_name(#n, "inverse"); \
+
+         register_ipow( 1) register_ipow( 2) register_ipow( 3) register_ipow( 4)
+         register_ipow( 5) register_ipow( 6) register_ipow( 7) register_ipow( 8)
+         register_ipow( 9) register_ipow(10) register_ipow(11) register_ipow(12)
+         register_ipow(13) register_ipow(14) register_ipow(15) register_ipow(16)
+         register_ipow(17) register_ipow(18) register_ipow(19) register_ipow(20)
+         register_ipow(21) register_ipow(22) register_ipow(23) register_ipow(24)
+         register_ipow(25) register_ipow(26) register_ipow(27) register_ipow(28)
+         register_ipow(29) register_ipow(30) register_ipow(31) register_ipow(32)
+         register_ipow(33) register_ipow(34) register_ipow(35) register_ipow(36)
+         register_ipow(37) register_ipow(38) register_ipow(39) register_ipow(40)
+         register_ipow(41) register_ipow(42) register_ipow(43) register_ipow(44)
+         register_ipow(45) register_ipow(46) register_ipow(47) register_ipow(48)
+         register_ipow(49) register_ipow(50) register_ipow(51) register_ipow(52)
+         register_ipow(53) register_ipow(54) register_ipow(55) register_ipow(56)
+         register_ipow(57) register_ipow(58) register_ipow(59) register_ipow(60)
+         #undef register_ipow
+      }
+
+      template<typename T> void cpp_generator<T>::add_variable(const std::string& name, const T& variable)
+      {
+         add_symbol(name, &variable, 0);
+      }
+
+      template<typename T> void cpp_generator<T>::add_vector(const std::string& name, const T* data, const std::size_t size)
+      {
+         add_symbol(name, data, size);
+      }
+
+      template<typename T> void cpp_generator<T>::add_function(const std::string& name, const ifunction<T>* function)
+      {
+         for (std::size_t i = 0; i < function_list_.size(); ++i)
+         {
+            if ((function_list_[i].first == name) || (function_list_[i].second == function))
+               return;
+         }
+
+         function_list_.push_back(function_t(name, function));
+      }
+
+      template<typename T> bool cpp_generator<T>::generate(const program_t& program, const std::string& name, std::string& source)
+      {
+         typedef typename program_t::opcode opcode_t;
+
+         error_.clear();
+         local_map_.clear();
+
+         if (!valid_identifier(name))
+         {
+            error_ = "'" + name + "' is not a valid function name";
+            return false;
+         }
+
+         for (std::size_t i = 0; i < symbol_list_.size(); ++i)
+         {
+            if (!valid_identifier(symbol_list_[i].name))
+            {
+               error_ = "'" + symbol_list_[i].name + "' is not a valid member name";
+               return false;
+            }
+         }
+
+         const std::vector<instruction_t>& instruction_list = program.instruction_list_;
+
+         if (instruction_list.empty())
+         {
+            error_ = "empty program";
+            return false;
+         }
+
+         const std::size_t count = instruction_list.size() - 1;
+
+         register_begin_ = program.register_list_.data();
+         register_end_   = register_begin_ + program.register_list_.size();
+         register_written_.assign(program.register_list_.size(), false);
+
+         std::vector<bool> target(count + 1, false);
+         std::vector<const T*> memory_list;
+         std::map<std::string, std::size_t> extern_map;
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            const instruction_t& inst = instruction_list[i];
+
+            switch (inst.op)
+            {
+               case program_t::e_jump       :
+               case program_t::e_jump_false : target[inst.target] = true;
+                                              break;
+
+               case program_t::e_call       : error_ = "the program calls back into the expression tree";
+                                              return false;
+
+               case program_t::e_vecvec     :
+               case program_t::e_vecval     :
+               case program_t::e_valvec     :
+               case program_t::e_vecunary   : error_ = "vector operations are not supported";
+                                              return false;
+
+               case program_t::e_function   : {
+                                                 std::size_t j = 0;
+
+                                                 while ((j < function_list_.size()) && (function_list_[j].second != inst.fop->function))
+                                                    ++j;
+
+                                                 if (function_list_.size() == j)
+                                                 {
+                                                    error_ = "call of an unregistered function";
+                                                    return false;
+                                                 }
+
+                                                 extern_map[function_list_[j].first] = inst.fop->argument_list.size();
+                                              }
+                                              break;
+
+               default                      : break;
+            }
+
+            if (0 == inst.r)
+               continue;
+            else if ((register_begin_ <= inst.r) && (inst.r < register_end_))
+               register_written_[inst.r - register_begin_] = true;
+            else if (symbol_operand(inst.r).empty() && (local_map_.end() == local_map_.find(inst.r)))
+            {
+               std::ostringstream local_name;
+               local_name << "mem_" << memory_list.size();
+               local_map_[inst.r] = local_name.str();
+               memory_list.push_back(inst.r);
+            }
+         }
+
+         std::ostringstream body;
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            const instruction_t& inst = instruction_list[i];
+            const opcode_t op = inst.op;
+
+            if (target[i])
+               body << "L" << i << ":\n";
+
+            const T* argument[] = { inst.a, inst.b, inst.c, 0 };
+            std::size_t arity = 0;
+            std::string function;
+
+            if (program_t::e_ufunc == op)
+            {
+               arity = 1;
+
+               const typename std::map<ufunc_t, std::string>::const_iterator itr = unary_name_map_.find(inst.uf);
+
+               if (unary_name_map_.end() != itr)
+                  function = itr->second;
+            }
+            else if (program_t::e_bfunc == op)
+            {
+               arity = 2;
+
+               const typename std::map<bfunc_t, std::string>::const_iterator itr = binary_name_map_.find(inst.bf);
+
+               if (binary_name_map_.end() != itr)
+                  function = itr->second;
+            }
+            else if (program_t::e_tfunc == op)
+            {
+               arity = 3;
+
+               const typename std::map<tfunc_t, std::string>::const_iterator itr = trinary_name_map_.find(inst.tf);
+
+               if (trinary_name_map_.end() != itr)
+                  function = itr->second;
+            }
+            else if (program_t::e_qfunc == op)
+            {
+               arity = 4;
+
+               const typename std::map<qfunc_t, std::string>::const_iterator itr = quaternary_name_map_.find(inst.qop->qf);
+
+               if (quaternary_name_map_.end() != itr)
+                  function = itr->second;
+
+               argument[3] = inst.qop->d;
+            }
+
+            switch (op)
+            {
+               case program_t::e_mov        : body << "   " << operand(inst.r) << " = " << operand(inst.a) << ";\n";
+                                              break;
+
+               case program_t::e_add        : body << "   " << operand(inst.r) << " = " << operand(inst.a) << " + " << operand(inst.b) << ";\n";
+                                              break;
+
+               case program_t::e_sub        : body << "   " << operand(inst.r) << " = " << operand(inst.a) << " - " << operand(inst.b) << ";\n";
+                                              break;
+
+               case program_t::e_mul        : body << "   " << operand(inst.r) << " = " << operand(inst.a) << " * " << operand(inst.b) << ";\n";
+                                              break;
+
+               case program_t::e_div        : body << "   " << operand(inst.r) << " = " << operand(inst.a) << " / " << operand(inst.b) << ";\n";
+                                              break;
+
+               case program_t::e_neg        : body << "   " << operand(inst.r) << " = -" << operand(inst.a) << ";\n";
+                                              break;
+
+               case program_t::e_ufunc      :
+               case program_t::e_bfunc      :
+               case program_t::e_tfunc      :
+               case program_t::e_qfunc      : if (function.empty())
+                                              {
+                                                 error_ = "call of a function with no known name";
+                                                 return false;
+                                              }
+
+                                              body << "   " << operand(inst.r) << " = "
+                                                   << call(function, argument, arity) << ";\n";
+                                              break;
+
+               case program_t::e_jump       : body << "   goto L" << inst.target << ";\n";
+                                              break;
+
+               case program_t::e_jump_false : body << "   if (!Essa::Math::details::is_true(" << operand(inst.a) << ")) goto L" << inst.target << ";\n";
+                                              break;
+
+               case program_t::e_select     : body << "   " << operand(inst.r) << " = Essa::Math::details::is_true(" << operand(inst.a) << ") ? "
+                                                   << operand(inst.b) << " : " << operand(inst.c) << ";\n";
+                                              break;
+
+               case program_t::e_function   : {
+                                                 const std::vector<const T*>& argument_list = inst.fop->argument_list;
+                                                 std::size_t j = 0;
+
+                                                 while (function_list_[j].second != inst.fop->function)
+                                                    ++j;
+
+                                                 body << "   " << operand(inst.r) << " = "
+                                                      << call(function_list_[j].first, argument_list.data(), argument_list.size()) << ";\n";
+                                              }
+                                              break;
+
+               default                      : break;
+            }
+         }
+
+         if (target[count])
+            body << "L" << count << ":\n";
+
+         body << "   return " << operand(program.result_) << ";\n";
+
+         std::ostringstream unit;
+
+         unit << "// Generated from an Essa::Math expression.\n"
+              << "#include \"include/Operators.hpp\"\n"
+              << "#include <limits>\n\n"
+              << "struct " << name << "_symbols\n"
+              << "{\n";
+
+         for (std::size_t i = 0; i < symbol_list_.size(); ++i)
+         {
+            if (symbol_list_[i].size)
+               unit << "   " << type_ << "* " << symbol_list_[i].name << "; // " << symbol_list_[i].size << " elements\n";
+            else
+               unit << "   " << type_ << " " << symbol_list_[i].name << ";\n";
+         }
+
+         unit << "};\n\n";
+
+         for (std::map<std::string, std::size_t>::const_iterator itr = extern_map.begin(); itr != extern_map.end(); ++itr)
+         {
+            unit << "extern \"C\" " << type_ << " " << itr->first << "(";
+
+            for (std::size_t i = 0; i < itr->second; ++i)
+            {
+               unit << (i ? ", " : "") << type_;
+            }
+
+            unit << ");\n\n";
+         }
+
+         unit << "extern \"C\" " << type_ << " " << name << "(" << name << "_symbols* symbols)\n"
+              << "{\n";
+
+         for (std::size_t i = 0; i < register_written_.size(); ++i)
+         {
+            if (register_written_[i])
+               unit << "   " << type_ << " reg_" << i << " = " << literal(register_begin_[i]) << ";\n";
+         }
+
+         for (std::size_t i = 0; i < memory_list.size(); ++i)
+         {
+            unit << "   " << type_ << " " << local_map_[memory_list[i]] << " = " << literal(*memory_list[i]) << ";\n";
+         }
+
+         unit << "\n" << body.str() << "}\n";
+
+         source = unit.str();
+
+         return true;
+      }
+
+      template<typename T> const std::string& cpp_generator<T>::error() const
+      {
+         return error_;
+      }
+
+      template<typename T> void cpp_generator<T>::add_symbol(const std::string& name, const T* data, const std::size_t size)
+      {
+         for (std::size_t i = 0; i < symbol_list_.size(); ++i)
+         {
+            if ((symbol_list_[i].name == name) || (symbol_list_[i].data == data))
+               return;
+         }
+
+         symbol s;
+         s.name = name;
+         s.data = data;
+         s.size = size;
+         symbol_list_.push_back(s);
+      }
+
+      template<typename T> std::string cpp_generator<T>::operand(const T* address) const
+      {
+         if ((register_begin_ <= address) && (address < register_end_))
+         {
+            const std::size_t index = address - register_begin_;
+
+            if (!register_written_[index])
+               return literal(*address);
+
+            std::ostringstream name;
+            name << "reg_" << index;
+            return name.str();
+         }
+
+         const std::string name = symbol_operand(address);
+
+         if (!name.empty())
+            return name;
+
+         const typename local_map_t::const_iterator itr = local_map_.find(address);
+
+         if (local_map_.end() != itr)
+            return itr->second;
+         else
+            return literal(*address);
+      }
+
+      template<typename T> std::string cpp_generator<T>::symbol_operand(const T* address) const
+      {
+         for (std::size_t i = 0; i < symbol_list_.size(); ++i)
+         {
+            const symbol& s = symbol_list_[i];
+
+            if ((0 == s.size) && (s.data == address))
+               return "symbols->" + s.name;
+            else if ((s.data <= address) && (address < s.data + s.size))
+            {
+               std::ostringstream name;
+               name << "symbols->" << s.name << "[" << (address - s.data) << "]";
+               return name.str();
+            }
+         }
+
+         return std::string();
+      }
+
+      template<typename T> std::string cpp_generator<T>::call(const std::string& function, const T* const* argument, const std::size_t count) const
+      {
+         std::string result = function + "(";
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            if (i)
+               result += ", ";
+
+            result += operand(argument[i]);
+         }
+
+         return result + ")";
+      }
+
+      template<typename T> std::string cpp_generator<T>::literal(const T& value) const
+      {
+         return number(value);
+      }
+
+      template<typename T> std::string cpp_generator<T>::op_name(const std::string& op) const
+      {
+         return "Essa::Math::details::" + op + "<" + type_ + ">::process";
+      }
+
+      template<typename T> std::string cpp_generator<T>::ipow_name(const std::string& n, const std::string& function) const
+      {
+         return "Essa::Math::details::ipow_function<" + type_ + ", Essa::Math::details::numeric::fast_exp<" + type_ + ", " + n + "> >::" + function;
+      }
+
+      template<typename T> bool cpp_generator<T>::valid_identifier(const std::string& name)
+      {
+         if (name.empty() || details::is_digit(name[0]))
+            return false;
+
+         for (std::size_t i = 0; i < name.size(); ++i)
+         {
+            if (!details::is_letter_or_digit(name[i]) && ('_' != name[i]))
+               return false;
+         }
+
+         return true;
+      }
+
+      template<typename T> std::string cpp_generator<T>::number(const int16_t& value)
+      {
+         return integer(value);
+      }
+
+      template<typename T> std::string cpp_generator<T>::number(const int32_t& value)
+      {
+         return integer(value);
+      }
+
+      template<typename T> std::string cpp_generator<T>::number(const int64_t& value)
+      {
+         return integer(value);
+      }
+
+      template<typename T> std::string cpp_generator<T>::number(const float& value)
+      {
+         return floating(value, "f");
+      }
+
+      template<typename T> std::string cpp_generator<T>::number(const double& value)
+      {
+         return floating(value, "");
+      }
+
+      template<typename T> std::string cpp_generator<T>::number(const long double& value)
+      {
+         return floating(value, "L");
+      }
+
+      template<typename T> template <typename U> std::string cpp_generator<T>::number(const std::complex<U>& value)
+      {
+         return std::string(type_name(value)) + "(" + number(value.real()) + ", " + number(value.imag()) + ")";
+      }
+
+      template<typename T> template <typename U> std::string cpp_generator<T>::integer(const U& value)
+      {
+         if (std::numeric_limits<U>::min() == value)
+            return std::string("std::numeric_limits<") + type_name(value) + ">::min()";
+
+         std::ostringstream result;
+
+         if (value < 0)
+            result << "(" << static_cast<int64_t>(value) << ")";
+         else
+            result << static_cast<int64_t>(value);
+
+         return result.str();
+      }
+
+      // Hexadecimal literals, which represent every finite value exactly.
+      template<typename T> template <typename U> std::string cpp_generator<T>::floating(const U& value, const char* suffix)
+      {
+         const std::string limits = std::string("std::numeric_limits<") + type_name(value) + ">::";
+
+         if (value != value)
+            return limits + "quiet_NaN()";
+         else if (std::numeric_limits<U>::infinity() == value)
+            return limits + "infinity()";
+         else if (-std::numeric_limits<U>::infinity() == value)
+            return "(-" + limits + "infinity())";
+
+         std::ostringstream result;
+
+         if (std::signbit(value))
+            result << "(" << std::hexfloat << value << suffix << ")";
+         else
+            result << std::hexfloat << value << suffix;
+
+         return result.str();
+      }
+
+      template<typename T> const char* cpp_generator<T>::type_name(const int16_t&)
+      {
+         return "int16_t";
+      }
+
+      template<typename T> const char* cpp_generator<T>::type_name(const int32_t&)
+      {
+         return "int32_t";
+      }
+
+      template<typename T> const char* cpp_generator<T>::type_name(const int64_t&)
+      {
+         return "int64_t";
+      }
+
+      template<typename T> const char* cpp_generator<T>::type_name(const float&)
+      {
+         return "float";
+      }
+
+      template<typename T> const char* cpp_generator<T>::type_name(const double&)
+      {
+         return "double";
+      }
+
+      template<typename T> const char* cpp_generator<T>::type_name(const long double&)
+      {
+         return "long double";
+      }
+
+      template<typename T> const char* cpp_generator<T>::type_name(const std::complex<float>&)
+      {
+         return "std::complex<float>";
+      }
+
+      template<typename T> const char* cpp_generator<T>::type_name(const std::complex<double>&)
+      {
+         return "std::complex<double>";
+      }
+
+      template<typename T> const char* cpp_generator<T>::type_name(const std::complex<long double>&)
+      {
+         return "std::complex<long double>";
+      }
+
+      template class cpp_generator<int16_t>;
+      template class cpp_generator<int32_t>;
+      template class cpp_generator<int64_t>;
+      template class cpp_generator<float>;
+      template class cpp_generator<double>;
+      template class cpp_generator<long double>;
+      template class cpp_generator<std::complex<float>>;
+      template class cpp_generator<std::complex<double>>;
+      template class cpp_generator<std::complex<long double>>;
+   }
+}
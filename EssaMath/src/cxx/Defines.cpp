@@ -1,5 +1,6 @@
 #include "include/Defines.hpp"
 #include <algorithm>
+#include <unordered_set>
 
 namespace Essa::Math
 {
@@ -12,9 +13,7 @@ namespace Essa::Math
       bool disable_superscalar_unroll = false;
       bool disable_comments = true;
       bool disable_return_statement = true;
-      bool disable_enhanced_features = false;
       bool disable_sc_andor = true;
-      bool disable_cardinal_pow_optimisation = false;
 
       bool is_whitespace(const char_t c)
       {
@@ -114,7 +113,7 @@ namespace Essa::Math
          }
       }
 
-      bool imatch(const std::string& s1, const std::string& s2)
+      bool imatch(std::string_view s1, std::string_view s2)
       {
          if(!disable_caseinsensitivity){
             if (s1.size() == s2.size())
@@ -158,6 +157,28 @@ namespace Essa::Math
         }
     }
 
+    std::size_t ihash::operator() (const std::string& s) const
+    {
+        // FNV-1a over the case folded characters, so that names which
+        // imatch each other always land in the same bucket.
+        std::size_t result = static_cast<std::size_t>(14695981039346656037ULL);
+
+        for (std::size_t i = 0; i < s.size(); ++i)
+        {
+            const uchar_t c = static_cast<uchar_t>(s[i]);
+
+            result ^= disable_caseinsensitivity ? c : static_cast<uchar_t>(std::tolower(c));
+            result *= static_cast<std::size_t>(1099511628211ULL);
+        }
+
+        return result;
+    }
+
+    bool iequal_to::operator() (const std::string& s1, const std::string& s2) const
+    {
+        return imatch(s1, s2);
+    }
+
     bool is_valid_sf_symbol(const std::string& symbol)
     {
         // Special function: $f12 or $F34
@@ -408,30 +429,20 @@ namespace Essa::Math
 
     const std::size_t inequality_ops_list_size = sizeof(inequality_ops_list) / sizeof(std::string);
 
+      typedef std::unordered_set<std::string,ihash,iequal_to> reserved_set_t;
+
       bool is_reserved_word(const std::string& symbol)
       {
-         for (std::size_t i = 0; i < reserved_words_size; ++i)
-         {
-            if (imatch(symbol, reserved_words[i]))
-            {
-               return true;
-            }
-         }
+         static const reserved_set_t reserved_word_set(reserved_words, reserved_words + reserved_words_size);
 
-         return false;
+         return reserved_word_set.end() != reserved_word_set.find(symbol);
       }
 
       bool is_reserved_symbol(const std::string& symbol)
       {
-         for (std::size_t i = 0; i < reserved_symbols_size; ++i)
-         {
-            if (imatch(symbol, reserved_symbols[i]))
-            {
-               return true;
-            }
-         }
+         static const reserved_set_t reserved_symbol_set(reserved_symbols, reserved_symbols + reserved_symbols_size);
 
-         return false;
+         return reserved_symbol_set.end() != reserved_symbol_set.find(symbol);
       }
 
       bool is_base_function(const std::string& function_name)
@@ -0,0 +1,796 @@
+#include "include/Derivative.hpp"
+#include "include/Operators.hpp"
+#include <algorithm>
+
+namespace Essa::Math{
+   namespace details
+   {
+      // A value with its derivative along one direction. Evaluating the
+      // special functions on it yields their partial derivatives.
+      template <typename T>
+      struct dual_number
+      {
+         dual_number(const T& v, const T& t = T(0))
+         : value(v)
+         , tangent(t)
+         {}
+
+         T value;
+         T tangent;
+      };
+
+      template <typename T>
+      inline dual_number<T> operator+(const dual_number<T>& a, const dual_number<T>& b)
+      {
+         return dual_number<T>(a.value + b.value, a.tangent + b.tangent);
+      }
+
+      template <typename T>
+      inline dual_number<T> operator-(const dual_number<T>& a, const dual_number<T>& b)
+      {
+         return dual_number<T>(a.value - b.value, a.tangent - b.tangent);
+      }
+
+      template <typename T>
+      inline dual_number<T> operator*(const dual_number<T>& a, const dual_number<T>& b)
+      {
+         return dual_number<T>(a.value * b.value, a.tangent * b.value + a.value * b.tangent);
+      }
+
+      template <typename T>
+      inline dual_number<T> operator/(const dual_number<T>& a, const dual_number<T>& b)
+      {
+         const T value = a.value / b.value;
+         return dual_number<T>(value, (a.tangent - value * b.tangent) / b.value);
+      }
+
+      template <typename T>
+      struct partial_derivative
+      {
+         typedef dual_number<T>                 dual_t;
+         typedef typename functor_t<T>::qfunc_t qfunc_t;
+
+         template <T (*Rule)(const T, const T)>
+         static void unary(const T* x, const T& r, T* p)
+         {
+            p[0] = Rule(x[0], r);
+         }
+
+         static T zero (const T  , const T  ) { return T(0);  }
+         static T one  (const T  , const T  ) { return T(1);  }
+         static T neg  (const T  , const T  ) { return T(-1); }
+         static T abs  (const T a, const T  ) { return numeric::sgn(a); }
+         static T acos (const T a, const T  ) { return T(-1) / numeric::sqrt<T>(T(1) - a * a); }
+         static T acosh(const T a, const T  ) { return T( 1) / numeric::sqrt<T>(a * a - T(1)); }
+         static T asin (const T a, const T  ) { return T( 1) / numeric::sqrt<T>(T(1) - a * a); }
+         static T asinh(const T a, const T  ) { return T( 1) / numeric::sqrt<T>(a * a + T(1)); }
+         static T atan (const T a, const T  ) { return T( 1) / (T(1) + a * a); }
+         static T atanh(const T a, const T  ) { return T( 1) / (T(1) - a * a); }
+         static T cos  (const T a, const T  ) { return -numeric::sin(a); }
+         static T cosh (const T a, const T  ) { return numeric::sinh(a); }
+         static T cot  (const T  , const T r) { return -(T(1) + r * r); }
+         static T csc  (const T a, const T r) { return -r * numeric::cot(a); }
+         static T d2g  (const T  , const T  ) { return numeric::d2g(T(1)); }
+         static T d2r  (const T  , const T  ) { return numeric::d2r(T(1)); }
+         static T g2d  (const T  , const T  ) { return numeric::g2d(T(1)); }
+         static T r2d  (const T  , const T  ) { return numeric::r2d(T(1)); }
+         static T erf  (const T a, const T  ) { return  T(2) / numeric::sqrt(T(numeric::constant::pi)) * numeric::exp<T>(-a * a); }
+         static T erfc (const T a, const T  ) { return T(-2) / numeric::sqrt(T(numeric::constant::pi)) * numeric::exp<T>(-a * a); }
+         static T exp  (const T  , const T r) { return r; }
+         static T expm1(const T  , const T r) { return r + T(1); }
+         static T log  (const T a, const T  ) { return T(1) / a; }
+         static T log10(const T a, const T  ) { return T(1) / (a * numeric::log(T(10))); }
+         static T log2 (const T a, const T  ) { return T(1) / (a * T(numeric::constant::log2)); }
+         static T log1p(const T a, const T  ) { return T(1) / (T(1) + a); }
+         // ncdf evaluates the Dawson function F, F'(a) = 1 - 2aF(a).
+         static T ncdf (const T a, const T r) { return T(1) - T(2) * a * r; }
+         static T sec  (const T a, const T r) { return r * numeric::tan(a); }
+         static T sin  (const T a, const T  ) { return numeric::cos(a); }
+         static T sinh (const T a, const T  ) { return numeric::cosh(a); }
+         static T sqrt (const T  , const T r) { return T(1) / (T(2) * r); }
+         static T tan  (const T  , const T r) { return T(1) + r * r; }
+         static T tanh (const T  , const T r) { return T(1) - r * r; }
+
+         static T sinc (const T a, const T r)
+         {
+            return std::equal_to<T>()(T(0), a) ? T(0) : (numeric::cos(a) - r) / a;
+         }
+
+         template <unsigned int N>
+         static T ipow(const T a, const T)
+         {
+            return T(N) * numeric::fast_exp<T,N - 1>::result(a);
+         }
+
+         template <unsigned int N>
+         static T ipow_inverse(const T a, const T r)
+         {
+            return T(-1) * T(N) * r / a;
+         }
+
+         static void mod(const T* x, const T&, T* p)
+         {
+            p[0] = T(1);
+            p[1] = -numeric::trunc<T>(x[0] / x[1]);
+         }
+
+         // Terms that do not exist, such as the one of the exponent where
+         // the base is zero or negative, are taken as zero so they cannot
+         // turn the derivative into a NaN when the argument is constant.
+         static void pow(const T* x, const T& r, T* p)
+         {
+            const T l = numeric::log(x[0]);
+
+            p[0] = std::equal_to<T>()(T(0), x[1]) ? T(0) : x[1] * numeric::pow<T>(x[0], x[1] - T(1));
+            p[1] = (std::equal_to<T>()(T(0), r) || std::not_equal_to<T>()(l, l)) ? T(0) : r * l;
+         }
+
+         static void constant(const T*, const T&, T* p)
+         {
+            p[0] = T(0);
+            p[1] = T(0);
+            p[2] = T(0);
+            p[3] = T(0);
+         }
+
+         template <template <typename> class Operation>
+         static void sf3(const T* x, const T&, T* p)
+         {
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+               p[i] = Operation<dual_t>::process(dual_t(x[0], T(0 == i ? 1 : 0)),
+                                                 dual_t(x[1], T(1 == i ? 1 : 0)),
+                                                 dual_t(x[2], T(2 == i ? 1 : 0))).tangent;
+            }
+         }
+
+         template <template <typename> class Operation>
+         static void sf4(const T* x, const T&, T* p)
+         {
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+               p[i] = Operation<dual_t>::process(dual_t(x[0], T(0 == i ? 1 : 0)),
+                                                 dual_t(x[1], T(1 == i ? 1 : 0)),
+                                                 dual_t(x[2], T(2 == i ? 1 : 0)),
+                                                 dual_t(x[3], T(3 == i ? 1 : 0))).tangent;
+            }
+         }
+
+         // x * f(y) +/- z
+         template <T (*Function)(const T), T (*Derivative)(const T, const T), int Sign>
+         static void sf_xfy(const T* x, const T&, T* p)
+         {
+            p[0] = Function(x[1]);
+            p[1] = x[0] * Derivative(x[1], p[0]);
+            p[2] = T(Sign);
+         }
+
+         // The argument the condition selects has derivative one.
+         static void sf47(const T* x, const T&, T* p)
+         {
+            const bool condition = is_true(x[0]);
+
+            p[0] = T(0);
+            p[1] = T(condition ? 1 : 0);
+            p[2] = T(condition ? 0 : 1);
+         }
+
+         template <qfunc_t Operation>
+         static void sf_select(const T* x, const T&, T* p)
+         {
+            const bool condition = is_true(Operation(x[0], x[1], T(1), T(0)));
+
+            p[0] = T(0);
+            p[1] = T(0);
+            p[2] = T(condition ? 1 : 0);
+            p[3] = T(condition ? 0 : 1);
+         }
+
+         static void sf99(const T* x, const T&, T* p)
+         {
+            p[0] = numeric::sin(x[1]);
+            p[1] = x[0] * numeric::cos(x[1]);
+            p[2] = numeric::cos(x[3]);
+            p[3] = -x[2] * numeric::sin(x[3]);
+         }
+      };
+
+      template<typename T> derivative_rules<T>::derivative_rules()
+      {
+         typedef partial_derivative<T> pd_t;
+
+         #define register_unary_rule(op, rule)                                                  \
+         unary_map_[static_cast<ufunc_t>(&op##_op<T>::process)] = &pd_t::template unary<&pd_t::rule>; \
+
+         register_unary_rule(abs  , abs  ) register_unary_rule(acos , acos ) register_unary_rule(acosh, acosh)
+         register_unary_rule(asin , asin ) register_unary_rule(asinh, asinh) register_unary_rule(atan , atan )
+         register_unary_rule(atanh, atanh) register_unary_rule(ceil , zero ) register_unary_rule(cos  , cos  )
+         register_unary_rule(cosh , cosh ) register_unary_rule(cot  , cot  ) register_unary_rule(csc  , csc  )
+         register_unary_rule(d2g  , d2g  ) register_unary_rule(d2r  , d2r  ) register_unary_rule(erf  , erf  )
+         register_unary_rule(erfc , erfc ) register_unary_rule(exp  , exp  ) register_unary_rule(expm1, expm1)
+         register_unary_rule(floor, zero ) register_unary_rule(frac , one  ) register_unary_rule(g2d  , g2d  )
+         register_unary_rule(log  , log  ) register_unary_rule(log10, log10) register_unary_rule(log2 , log2 )
+         register_unary_rule(log1p, log1p) register_unary_rule(ncdf , ncdf ) register_unary_rule(neg  , neg  )
+         register_unary_rule(notl , zero ) register_unary_rule(pos  , one  ) register_unary_rule(r2d  , r2d  )
+         register_unary_rule(round, zero ) register_unary_rule(sec  , sec  ) register_unary_rule(sgn  , zero )
+         register_unary_rule(sin  , sin  ) register_unary_rule(sinc , sinc ) register_unary_rule(sinh , sinh )
+         register_unary_rule(sqrt , sqrt ) register_unary_rule(tan  , tan  ) register_unary_rule(tanh , tanh )
+         register_unary_rule(trunc, zero )
+         #undef register_unary_rule
+
+         #define register_binary_rule(op, rule)                                  \
+         binary_map_[static_cast<bfunc_t>(&op<T>::process)] = &pd_t::rule; \
+
+         register_binary_rule(mod_op , mod     ) register_binary_rule(pow_op , pow     )
+         register_binary_rule(lt_op  , constant) register_binary_rule(lte_op , constant)
+         register_binary_rule(gt_op  , constant) register_binary_rule(gte_op , constant)
+         register_binary_rule(eq_op  , constant) register_binary_rule(equal_op, constant)
+         register_binary_rule(ne_op  , constant) register_binary_rule(and_op , constant)
+         register_binary_rule(nand_op, constant) register_binary_rule(or_op  , constant)
+         register_binary_rule(nor_op , constant) register_binary_rule(xor_op , constant)
+         register_binary_rule(xnor_op, constant)
+         #undef register_binary_rule
+
+         #define register_sf3_rule(NN)                                                   \
+         trinary_map_[&sf##NN##_op<T>::process] = &pd_t::template sf3<sf##NN##_op>; \
+
+         register_sf3_rule(00) register_sf3_rule(01) register_sf3_rule(02) register_sf3_rule(03)
+         register_sf3_rule(04) register_sf3_rule(05) register_sf3_rule(06) register_sf3_rule(07)
+         register_sf3_rule(08) register_sf3_rule(09) register_sf3_rule(10) register_sf3_rule(11)
+         register_sf3_rule(12) register_sf3_rule(13) register_sf3_rule(14) register_sf3_rule(15)
+         register_sf3_rule(16) register_sf3_rule(17) register_sf3_rule(18) register_sf3_rule(19)
+         register_sf3_rule(20) register_sf3_rule(21) register_sf3_rule(22) register_sf3_rule(23)
+         register_sf3_rule(24) register_sf3_rule(25) register_sf3_rule(26) register_sf3_rule(27)
+         register_sf3_rule(28) register_sf3_rule(29) register_sf3_rule(30) register_sf3_rule(31)
+         register_sf3_rule(32) register_sf3_rule(33) register_sf3_rule(34) register_sf3_rule(35)
+         register_sf3_rule(36) register_sf3_rule(37) register_sf3_rule(38)
+         #undef register_sf3_rule
+
+         trinary_map_[&sf39_op<T>::process] = &pd_t::template sf_xfy<&numeric::log<T>  , &pd_t::log  , +1>;
+         trinary_map_[&sf40_op<T>::process] = &pd_t::template sf_xfy<&numeric::log<T>  , &pd_t::log  , -1>;
+         trinary_map_[&sf41_op<T>::process] = &pd_t::template sf_xfy<&numeric::log10<T>, &pd_t::log10, +1>;
+         trinary_map_[&sf42_op<T>::process] = &pd_t::template sf_xfy<&numeric::log10<T>, &pd_t::log10, -1>;
+         trinary_map_[&sf43_op<T>::process] = &pd_t::template sf_xfy<&numeric::sin<T>  , &pd_t::sin  , +1>;
+         trinary_map_[&sf44_op<T>::process] = &pd_t::template sf_xfy<&numeric::sin<T>  , &pd_t::sin  , -1>;
+         trinary_map_[&sf45_op<T>::process] = &pd_t::template sf_xfy<&numeric::cos<T>  , &pd_t::cos  , +1>;
+         trinary_map_[&sf46_op<T>::process] = &pd_t::template sf_xfy<&numeric::cos<T>  , &pd_t::cos  , -1>;
+         trinary_map_[&sf47_op<T>::process] = &pd_t::sf47;
+
+         #define register_sf4_rule(NN)                                                      \
+         quaternary_map_[&sf##NN##_op<T>::process] = &pd_t::template sf4<sf##NN##_op>; \
+
+         register_sf4_rule(48) register_sf4_rule(49) register_sf4_rule(50) register_sf4_rule(51)
+         register_sf4_rule(52) register_sf4_rule(53) register_sf4_rule(54) register_sf4_rule(55)
+         register_sf4_rule(56) register_sf4_rule(57) register_sf4_rule(58) register_sf4_rule(59)
+         register_sf4_rule(60) register_sf4_rule(61) register_sf4_rule(62) register_sf4_rule(63)
+         register_sf4_rule(64) register_sf4_rule(65) register_sf4_rule(66) register_sf4_rule(67)
+         register_sf4_rule(68) register_sf4_rule(69) register_sf4_rule(70) register_sf4_rule(71)
+         register_sf4_rule(72) register_sf4_rule(73) register_sf4_rule(74) register_sf4_rule(75)
+         register_sf4_rule(76) register_sf4_rule(77) register_sf4_rule(78) register_sf4_rule(79)
+         register_sf4_rule(80) register_sf4_rule(81) register_sf4_rule(82) register_sf4_rule(83)
+         register_sf4_rule(84) register_sf4_rule(85) register_sf4_rule(86) register_sf4_rule(87)
+         register_sf4_rule(88) register_sf4_rule(89) register_sf4_rule(90) register_sf4_rule(91)
+
+         register_sf4_rule(ext00) register_sf4_rule(ext01) register_sf4_rule(ext02) register_sf4_rule(ext03)
+         register_sf4_rule(ext04) register_sf4_rule(ext05) register_sf4_rule(ext06) register_sf4_rule(ext07)
+         register_sf4_rule(ext08) register_sf4_rule(ext09) register_sf4_rule(ext10) register_sf4_rule(ext11)
+         register_sf4_rule(ext12) register_sf4_rule(ext13) register_sf4_rule(ext14) register_sf4_rule(ext15)
+         register_sf4_rule(ext16) register_sf4_rule(ext17) register_sf4_rule(ext18) register_sf4_rule(ext19)
+         register_sf4_rule(ext20) register_sf4_rule(ext21) register_sf4_rule(ext22) register_sf4_rule(ext23)
+         register_sf4_rule(ext24) register_sf4_rule(ext25) register_sf4_rule(ext26) register_sf4_rule(ext27)
+         register_sf4_rule(ext28) register_sf4_rule(ext29) register_sf4_rule(ext30) register_sf4_rule(ext31)
+         register_sf4_rule(ext32) register_sf4_rule(ext33) register_sf4_rule(ext34) register_sf4_rule(ext35)
+         register_sf4_rule(ext36) register_sf4_rule(ext37) register_sf4_rule(ext38) register_sf4_rule(ext39)
+         register_sf4_rule(ext40) register_sf4_rule(ext41) register_sf4_rule(ext42) register_sf4_rule(ext43)
+         register_sf4_rule(ext44) register_sf4_rule(ext45) register_sf4_rule(ext46) register_sf4_rule(ext47)
+         register_sf4_rule(ext48) register_sf4_rule(ext49) register_sf4_rule(ext50) register_sf4_rule(ext51)
+         register_sf4_rule(ext52) register_sf4_rule(ext53) register_sf4_rule(ext54) register_sf4_rule(ext55)
+         register_sf4_rule(ext56) register_sf4_rule(ext57) register_sf4_rule(ext58) register_sf4_rule(ext59)
+         register_sf4_rule(ext60) register_sf4_rule(ext61)
+         #undef register_sf4_rule
+
+         #define register_sf4_select_rule(NN)                                                    \
+         quaternary_map_[&sf##NN##_op<T>::process] = &pd_t::template sf_select<&sf##NN##_op<T>::process>; \
+
+         register_sf4_select_rule(92) register_sf4_select_rule(93) register_sf4_select_rule(94)
+         register_sf4_select_rule(95) register_sf4_select_rule(96) register_sf4_select_rule(97)
+         register_sf4_select_rule(98)
+         #undef register_sf4_select_rule
+
+         quaternary_map_[&sf99_op<T>::process] = &pd_t::sf99;
+
+         #define register_ipow_rule(n)                                                                                       \
+         unary_map_[&ipow_function<T,numeric::fast_exp<T,n> >::process] = &pd_t::template unary<&pd_t::template ipow<n> >;         \
+         unary_map_[&ipow_function<T,numeric::fast_exp<T,n> >::inverse] = &pd_t::template unary<&pd_t::template ipow_inverse<n> >; \
+
+         register_ipow_rule( 1) register_ipow_rule( 2) register_ipow_rule( 3) register_ipow_rule( 4)
+         register_ipow_rule( 5) register_ipow_rule( 6) register_ipow_rule( 7) register_ipow_rule( 8)
+         register_ipow_rule( 9) register_ipow_rule(10) register_ipow_rule(11) register_ipow_rule(12)
+         register_ipow_rule(13) register_ipow_rule(14) register_ipow_rule(15) register_ipow_rule(16)
+         register_ipow_rule(17) register_ipow_rule(18) register_ipow_rule(19) register_ipow_rule(20)
+         register_ipow_rule(21) register_ipow_rule(22) register_ipow_rule(23) register_ipow_rule(24)
+         register_ipow_rule(25) register_ipow_rule(26) register_ipow_rule(27) register_ipow_rule(28)
+         register_ipow_rule(29) register_ipow_rule(30) register_ipow_rule(31) register_ipow_rule(32)
+         register_ipow_rule(33) register_ipow_rule(34) register_ipow_rule(35) register_ipow_rule(36)
+         register_ipow_rule(37) register_ipow_rule(38) register_ipow_rule(39) register_ipow_rule(40)
+         register_ipow_rule(41) register_ipow_rule(42) register_ipow_rule(43) register_ipow_rule(44)
+         register_ipow_rule(45) register_ipow_rule(46) register_ipow_rule(47) register_ipow_rule(48)
+         register_ipow_rule(49) register_ipow_rule(50) register_ipow_rule(51) register_ipow_rule(52)
+         register_ipow_rule(53) register_ipow_rule(54) register_ipow_rule(55) register_ipow_rule(56)
+         register_ipow_rule(57) register_ipow_rule(58) register_ipow_rule(59) register_ipow_rule(60)
+         #undef register_ipow_rule
+      }
+
+      template<typename T> typename derivative_rules<T>::partial_t derivative_rules<T>::find(const instruction_t& inst) const
+      {
+         switch (inst.op)
+         {
+            case program_t::e_ufunc : {
+                                         const typename std::map<ufunc_t, partial_t>::const_iterator itr = unary_map_.find(inst.uf);
+                                         return (unary_map_.end() != itr) ? itr->second : 0;
+                                      }
+
+            case program_t::e_bfunc : {
+                                         const typename std::map<bfunc_t, partial_t>::const_iterator itr = binary_map_.find(inst.bf);
+                                         return (binary_map_.end() != itr) ? itr->second : 0;
+                                      }
+
+            case program_t::e_tfunc : {
+                                         const typename std::map<tfunc_t, partial_t>::const_iterator itr = trinary_map_.find(inst.tf);
+                                         return (trinary_map_.end() != itr) ? itr->second : 0;
+                                      }
+
+            case program_t::e_qfunc : {
+                                         const typename std::map<qfunc_t, partial_t>::const_iterator itr = quaternary_map_.find(inst.qop->qf);
+                                         return (quaternary_map_.end() != itr) ? itr->second : 0;
+                                      }
+
+            default                 : return 0;
+         }
+      }
+
+      template<typename T> derivative_program<T>::derivative_program()
+      : valid_(false)
+      {}
+
+      template<typename T> bool derivative_program<T>::compile(const expression_node<T>* root)
+      {
+         if (valid_)
+            return true;
+
+         bytecode_builder<T> builder(program_);
+
+         if (!builder.build(root))
+            return false;
+
+         const derivative_rules<T> rules;
+         const std::vector<instruction_t>& instruction_list = program_.instruction_list_;
+
+         instruction_list_.resize(instruction_list.size());
+
+         for (std::size_t i = 0; i < instruction_list.size(); ++i)
+         {
+            const instruction_t& inst = instruction_list[i];
+            derivative_instruction& tinst = instruction_list_[i];
+
+            std::fill_n(tinst.slot, 5, std::size_t(0));
+            tinst.arity   = 0;
+            tinst.partial = 0;
+
+            exprtk_disable_fallthrough_begin
+            switch (inst.op)
+            {
+               case program_t::e_halt       : tinst.slot[0] = slot(program_.result_);
+                                              continue;
+
+               case program_t::e_jump       :
+               case program_t::e_jump_false : continue;
+
+               case program_t::e_mov        :
+               case program_t::e_neg        : tinst.slot[1] = slot(inst.a);
+                                              tinst.arity   = 1;
+                                              break;
+
+               case program_t::e_add        :
+               case program_t::e_sub        :
+               case program_t::e_mul        :
+               case program_t::e_div        : tinst.slot[1] = slot(inst.a);
+                                              tinst.slot[2] = slot(inst.b);
+                                              tinst.arity   = 2;
+                                              break;
+
+               case program_t::e_select     : tinst.slot[1] = slot(inst.b);
+                                              tinst.slot[2] = slot(inst.c);
+                                              tinst.arity   = 2;
+                                              break;
+
+               case program_t::e_qfunc      : tinst.slot[4] = slot(inst.qop->d);
+                                              ++tinst.arity;
+               case program_t::e_tfunc      : tinst.slot[3] = slot(inst.c);
+                                              ++tinst.arity;
+               case program_t::e_bfunc      : tinst.slot[2] = slot(inst.b);
+                                              ++tinst.arity;
+               case program_t::e_ufunc      : tinst.slot[1] = slot(inst.a);
+                                              ++tinst.arity;
+                                              tinst.partial = rules.find(inst);
+
+                                              if (0 == tinst.partial)
+                                                 return false;
+                                              break;
+
+               default                      : return false;
+            }
+            exprtk_disable_fallthrough_end
+
+            tinst.slot[0] = slot(inst.r);
+         }
+
+         const T* const register_begin = program_.register_list_.data();
+         const T* const register_end   = register_begin + program_.register_list_.size();
+
+         for (typename slot_map_t::const_iterator itr = slot_map_.begin(); itr != slot_map_.end(); ++itr)
+         {
+            if ((itr->first < register_begin) || (register_end <= itr->first))
+               variable_slot_list_.push_back(*itr);
+         }
+
+         valid_ = true;
+
+         return true;
+      }
+
+      template<typename T> T derivative_program<T>::value(const seed_t* seed_list, const std::size_t seed_count,
+                                                          T* derivative, const std::size_t directions) const
+      {
+         if (1 == directions)
+            return evaluate<1>(seed_list, seed_count, derivative, directions);
+         else
+            return evaluate<0>(seed_list, seed_count, derivative, directions);
+      }
+
+      template<typename T> template <std::size_t Directions>
+      T derivative_program<T>::evaluate(const seed_t* seed_list, const std::size_t seed_count,
+                                        T* derivative, const std::size_t directions) const
+      {
+         typedef typename program_t::opcode opcode_t;
+
+         const std::size_t n = Directions ? Directions : directions;
+
+         tangent_.assign(slot_map_.size() * n, T(0));
+
+         for (std::size_t i = 0; i < seed_count; ++i)
+         {
+            const std::size_t index = variable_slot(seed_list[i].variable);
+
+            if (index < slot_map_.size())
+               std::copy(seed_list[i].direction, seed_list[i].direction + n, &tangent_[index * n]);
+         }
+
+         const std::vector<instruction_t>& instruction_list = program_.instruction_list_;
+         T* const tangent = tangent_.empty() ? 0 : &tangent_[0];
+         std::size_t i = 0;
+
+         for ( ; ; )
+         {
+            const instruction_t& inst = instruction_list[i];
+            const derivative_instruction& tinst = instruction_list_[i];
+            const opcode_t op = inst.op;
+
+            T* const r = tangent + tinst.slot[0] * n;
+            const T* const a = tangent + tinst.slot[1] * n;
+            const T* const b = tangent + tinst.slot[2] * n;
+
+            switch (op)
+            {
+               case program_t::e_halt       : std::copy(r, r + n, derivative);
+                                              return *program_.result_;
+
+               case program_t::e_jump       : i = inst.target;
+                                              continue;
+
+               case program_t::e_jump_false : i = is_true(*inst.a) ? i + 1 : inst.target;
+                                              continue;
+
+               case program_t::e_mov        : for (std::size_t k = 0; k < n; ++k) r[k] = a[k];
+                                              *inst.r = *inst.a;
+                                              break;
+
+               case program_t::e_neg        : for (std::size_t k = 0; k < n; ++k) r[k] = -a[k];
+                                              *inst.r = -(*inst.a);
+                                              break;
+
+               case program_t::e_add        : for (std::size_t k = 0; k < n; ++k) r[k] = a[k] + b[k];
+                                              *inst.r = *inst.a + *inst.b;
+                                              break;
+
+               case program_t::e_sub        : for (std::size_t k = 0; k < n; ++k) r[k] = a[k] - b[k];
+                                              *inst.r = *inst.a - *inst.b;
+                                              break;
+
+               case program_t::e_mul        : {
+                                                 const T x = *inst.a;
+                                                 const T y = *inst.b;
+
+                                                 for (std::size_t k = 0; k < n; ++k) r[k] = a[k] * y + x * b[k];
+                                                 *inst.r = x * y;
+                                              }
+                                              break;
+
+               case program_t::e_div        : {
+                                                 const T y = *inst.b;
+                                                 const T v = *inst.a / y;
+
+                                                 for (std::size_t k = 0; k < n; ++k) r[k] = (a[k] - v * b[k]) / y;
+                                                 *inst.r = v;
+                                              }
+                                              break;
+
+               case program_t::e_select     : {
+                                                 const bool condition = is_true(*inst.a);
+                                                 const T* const s = condition ? a : b;
+
+                                                 for (std::size_t k = 0; k < n; ++k) r[k] = s[k];
+                                                 *inst.r = condition ? *inst.b : *inst.c;
+                                              }
+                                              break;
+
+               case program_t::e_ufunc      : {
+                                                 T p[4];
+                                                 const T x = *inst.a;
+                                                 const T v = inst.uf(x);
+
+                                                 tinst.partial(&x, v, p);
+
+                                                 for (std::size_t k = 0; k < n; ++k) r[k] = p[0] * a[k];
+                                                 *inst.r = v;
+                                              }
+                                              break;
+
+               case program_t::e_bfunc      : {
+                                                 T p[4];
+                                                 const T x[2] = { *inst.a, *inst.b };
+                                                 const T v = inst.bf(x[0], x[1]);
+
+                                                 tinst.partial(x, v, p);
+
+                                                 for (std::size_t k = 0; k < n; ++k) r[k] = p[0] * a[k] + p[1] * b[k];
+                                                 *inst.r = v;
+                                              }
+                                              break;
+
+               default                      : {
+                                                 T p[4];
+                                                 const bool quaternary = (program_t::e_qfunc == op);
+                                                 const T x[4] = { *inst.a, *inst.b, *inst.c, quaternary ? *inst.qop->d : T(0) };
+                                                 const T v = quaternary ? inst.qop->qf(x[0], x[1], x[2], x[3]) :
+                                                                          inst.tf(x[0], x[1], x[2]);
+                                                 const T* const c = tangent + tinst.slot[3] * n;
+                                                 const T* const d = tangent + tinst.slot[4] * n;
+
+                                                 tinst.partial(x, v, p);
+
+                                                 for (std::size_t k = 0; k < n; ++k)
+                                                 {
+                                                    r[k] = p[0] * a[k] + p[1] * b[k] + p[2] * c[k] + (quaternary ? p[3] * d[k] : T(0));
+                                                 }
+
+                                                 *inst.r = v;
+                                              }
+                                              break;
+            }
+
+            ++i;
+         }
+      }
+
+      template<typename T> T derivative_program<T>::gradient(const T* const* variable_list, const std::size_t variable_count,
+                                                             T* gradient) const
+      {
+         typedef typename program_t::opcode opcode_t;
+
+         const std::vector<instruction_t>& instruction_list = program_.instruction_list_;
+         std::size_t i = 0;
+
+         tape_.clear();
+
+         for ( ; ; )
+         {
+            const instruction_t& inst = instruction_list[i];
+            const opcode_t op = inst.op;
+
+            if (program_t::e_halt == op)
+               break;
+            else if (program_t::e_jump == op)
+            {
+               i = inst.target;
+               continue;
+            }
+            else if (program_t::e_jump_false == op)
+            {
+               i = is_true(*inst.a) ? i + 1 : inst.target;
+               continue;
+            }
+
+            tape_.push_back(tape_entry());
+
+            tape_entry& entry = tape_.back();
+            T* const p = entry.partial;
+
+            entry.instruction = i;
+
+            switch (op)
+            {
+               case program_t::e_mov        : p[0] = T(1);
+                                              *inst.r = *inst.a;
+                                              break;
+
+               case program_t::e_neg        : p[0] = T(-1);
+                                              *inst.r = -(*inst.a);
+                                              break;
+
+               case program_t::e_add        : p[0] = T(1);
+                                              p[1] = T(1);
+                                              *inst.r = *inst.a + *inst.b;
+                                              break;
+
+               case program_t::e_sub        : p[0] = T( 1);
+                                              p[1] = T(-1);
+                                              *inst.r = *inst.a - *inst.b;
+                                              break;
+
+               case program_t::e_mul        : {
+                                                 const T x = *inst.a;
+                                                 const T y = *inst.b;
+
+                                                 p[0] = y;
+                                                 p[1] = x;
+                                                 *inst.r = x * y;
+                                              }
+                                              break;
+
+               case program_t::e_div        : {
+                                                 const T y = *inst.b;
+                                                 const T v = *inst.a / y;
+
+                                                 p[0] = T(1) / y;
+                                                 p[1] = -v / y;
+                                                 *inst.r = v;
+                                              }
+                                              break;
+
+               case program_t::e_select     : {
+                                                 const bool condition = is_true(*inst.a);
+
+                                                 p[0] = condition ? T(1) : T(0);
+                                                 p[1] = condition ? T(0) : T(1);
+                                                 *inst.r = condition ? *inst.b : *inst.c;
+                                              }
+                                              break;
+
+               case program_t::e_ufunc      : {
+                                                 const T x = *inst.a;
+                                                 const T v = inst.uf(x);
+
+                                                 instruction_list_[i].partial(&x, v, p);
+                                                 *inst.r = v;
+                                              }
+                                              break;
+
+               case program_t::e_bfunc      : {
+                                                 const T x[2] = { *inst.a, *inst.b };
+                                                 const T v = inst.bf(x[0], x[1]);
+
+                                                 instruction_list_[i].partial(x, v, p);
+                                                 *inst.r = v;
+                                              }
+                                              break;
+
+               default                      : {
+                                                 const bool quaternary = (program_t::e_qfunc == op);
+                                                 const T x[4] = { *inst.a, *inst.b, *inst.c, quaternary ? *inst.qop->d : T(0) };
+                                                 const T v = quaternary ? inst.qop->qf(x[0], x[1], x[2], x[3]) :
+                                                                          inst.tf(x[0], x[1], x[2]);
+
+                                                 instruction_list_[i].partial(x, v, p);
+                                                 *inst.r = v;
+                                              }
+                                              break;
+            }
+
+            ++i;
+         }
+
+         // Writing a slot ends the life of the value it held, so its adjoint
+         // moves to the arguments of the write and restarts from zero.
+         tangent_.assign(slot_map_.size(), T(0));
+         tangent_[instruction_list_[i].slot[0]] = T(1);
+
+         T* const adjoint = &tangent_[0];
+
+         for (std::size_t j = tape_.size(); j > 0; --j)
+         {
+            const tape_entry& entry = tape_[j - 1];
+            const derivative_instruction& tinst = instruction_list_[entry.instruction];
+            const T r = adjoint[tinst.slot[0]];
+
+            adjoint[tinst.slot[0]] = T(0);
+
+            for (std::size_t k = 0; k < tinst.arity; ++k)
+            {
+               adjoint[tinst.slot[k + 1]] += entry.partial[k] * r;
+            }
+         }
+
+         if (
+              (gradient_variable_list_.size() != variable_count) ||
+              !std::equal(variable_list, variable_list + variable_count, gradient_variable_list_.begin())
+            )
+         {
+            gradient_variable_list_.assign(variable_list, variable_list + variable_count);
+            gradient_slot_list_.resize(variable_count);
+
+            for (std::size_t k = 0; k < variable_count; ++k)
+            {
+               gradient_slot_list_[k] = variable_slot(variable_list[k]);
+            }
+         }
+
+         for (std::size_t k = 0; k < variable_count; ++k)
+         {
+            const std::size_t index = gradient_slot_list_[k];
+            gradient[k] = (index < slot_map_.size()) ? adjoint[index] : T(0);
+         }
+
+         return *program_.result_;
+      }
+
+      template<typename T> bool derivative_program<T>::valid() const
+      {
+         return valid_;
+      }
+
+      template<typename T> std::size_t derivative_program<T>::slot(const T* address)
+      {
+         const typename slot_map_t::const_iterator itr = slot_map_.find(address);
+
+         if (slot_map_.end() != itr)
+            return itr->second;
+
+         const std::size_t index = slot_map_.size();
+         slot_map_[address] = index;
+
+         return index;
+      }
+
+      template<typename T> std::size_t derivative_program<T>::variable_slot(const T* variable) const
+      {
+         const typename std::vector<variable_slot_t>::const_iterator itr =
+            std::lower_bound(variable_slot_list_.begin(), variable_slot_list_.end(), variable_slot_t(variable, 0));
+
+         if ((variable_slot_list_.end() != itr) && (variable == itr->first))
+            return itr->second;
+
+         return slot_map_.size();
+      }
+
+      template class derivative_rules<int16_t>;
+      template class derivative_rules<int32_t>;
+      template class derivative_rules<int64_t>;
+      template class derivative_rules<float>;
+      template class derivative_rules<double>;
+      template class derivative_rules<long double>;
+      template class derivative_rules<std::complex<float>>;
+      template class derivative_rules<std::complex<double>>;
+      template class derivative_rules<std::complex<long double>>;
+
+      template class derivative_program<int16_t>;
+      template class derivative_program<int32_t>;
+      template class derivative_program<int64_t>;
+      template class derivative_program<float>;
+      template class derivative_program<double>;
+      template class derivative_program<long double>;
+      template class derivative_program<std::complex<float>>;
+      template class derivative_program<std::complex<double>>;
+      template class derivative_program<std::complex<long double>>;
+   }
+}
@@ -1,5 +1,6 @@
 #include "include/ExpressionGenerator.hpp"
 #include "include/Parser.hpp"
+#include "include/VectorMath.hpp"
 
 namespace Essa::Math{
 
@@ -398,7 +399,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (v0 / v1) / v2 --> (vovov) v0 / (v1 * v2)
                   if ((details::e_div == o0) && (details::e_div == o1))
@@ -464,7 +465,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // v0 / (v1 / v2) --> (vovov) (v0 * v2) / v1
                   if ((details::e_div == o0) && (details::e_div == o1))
@@ -531,7 +532,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (v0 / v1) / c --> (vovoc) v0 / (v1 * c)
                   if ((details::e_div == o0) && (details::e_div == o1))
@@ -597,7 +598,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // v0 / (v1 / c) --> (vocov) (v0 * c) / v1
                   if ((details::e_div == o0) && (details::e_div == o1))
@@ -663,7 +664,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (v0 / c) / v1 --> (vovoc) v0 / (v1 * c)
                   if ((details::e_div == o0) && (details::e_div == o1))
@@ -729,7 +730,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // v0 / (c / v1) --> (vovoc) (v0 * v1) / c
                   if ((details::e_div == o0) && (details::e_div == o1))
@@ -795,7 +796,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (c / v0) / v1 --> (covov) c / (v0 * v1)
                   if ((details::e_div == o0) && (details::e_div == o1))
@@ -862,7 +863,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // c / (v0 / v1) --> (covov) (c * v1) / v0
                   if ((details::e_div == o0) && (details::e_div == o1))
@@ -929,7 +930,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (c0 + v) + c1 --> (cov) (c0 + c1) + v
                   if ((details::e_add == o0) && (details::e_add == o1))
@@ -1049,7 +1050,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (c0) + (v + c1) --> (cov) (c0 + c1) + v
                   if ((details::e_add == o0) && (details::e_add == o1))
@@ -1182,7 +1183,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (c0) + (c1 + v) --> (cov) (c0 + c1) + v
                   if ((details::e_add == o0) && (details::e_add == o1))
@@ -1302,7 +1303,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (v + c0) + c1 --> (voc) v + (c0 + c1)
                   if ((details::e_add == o0) && (details::e_add == o1))
@@ -1452,7 +1453,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (v0 / v1) * (v2 / v3) --> (vovovov) (v0 * v2) / (v1 * v3)
                   if ((details::e_div == o0) && (details::e_mul == o1) && (details::e_div == o2))
@@ -1575,7 +1576,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (v0 / v1) * (v2 / c) --> (vovovoc) (v0 * v2) / (v1 * c)
                   if ((details::e_div == o0) && (details::e_mul == o1) && (details::e_div == o2))
@@ -1665,7 +1666,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (v0 / v1) * (c / v2) --> (vocovov) (v0 * c) / (v1 * v2)
                   if ((details::e_div == o0) && (details::e_mul == o1) && (details::e_div == o2))
@@ -1755,7 +1756,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (v0 / c) * (v1 / v2) --> (vovocov) (v0 * v1) / (c * v2)
                   if ((details::e_div == o0) && (details::e_mul == o1) && (details::e_div == o2))
@@ -1845,7 +1846,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (c / v0) * (v1 / v2) --> (covovov) (c * v1) / (v0 * v2)
                   if ((details::e_div == o0) && (details::e_mul == o1) && (details::e_div == o2))
@@ -1935,7 +1936,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (c0 + v0) + (c1 + v1) --> (covov) (c0 + c1) + v0 + v1
                   if ((details::e_add == o0) && (details::e_add == o1) && (details::e_add == o2))
@@ -2130,7 +2131,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (v0 + c0) + (v1 + c1) --> (covov) (c0 + c1) + v0 + v1
                   if ((details::e_add == o0) && (details::e_add == o1) && (details::e_add == o2))
@@ -2375,7 +2376,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (c0 + v0) + (v1 + c1) --> (covov) (c0 + c1) + v0 + v1
                   if ((details::e_add == o0) && (details::e_add == o1) && (details::e_add == o2))
@@ -2570,7 +2571,7 @@ namespace Essa::Math{
 
                details::expression_node<T>* result = expression_generator<T>::error_node();
 
-               if (expr_gen.parser()->settings().strength_reduction_enabled())
+               if (expr_gen.strength_reduction_enabled())
                {
                   // (v0 + c0) + (c1 + v1) --> (covov) (c0 + c1) + v0 + v1
                   if ((details::e_add == o0) && (details::e_add == o1) && (details::e_add == o2))
@@ -5793,8 +5794,6 @@ namespace Essa::Math{
 
         template<typename T> void expression_generator<T>::init_synthesize_map()
          {
-            if(details::disable_enhanced_features)
-               return;
             synthesize_map_["(v)o(v)"] = synthesize_vov_expression<T>::process;
             synthesize_map_["(c)o(v)"] = synthesize_cov_expression<T>::process;
             synthesize_map_["(v)o(c)"] = synthesize_voc_expression<T>::process;
@@ -5909,6 +5908,32 @@ namespace Essa::Math{
             return strength_reduction_enabled_;
          }
 
+         template<typename T> void expression_generator<T>::set_enhanced_features_state(const bool enabled)
+         {
+            enhanced_features_enabled_ = enabled;
+         }
+
+         template<typename T> bool expression_generator<T>::enhanced_features_enabled() const
+         {
+            return enhanced_features_enabled_;
+         }
+
+         template<typename T> void expression_generator<T>::set_cardinal_pow_optimisation_state(const bool enabled)
+         {
+            cardinal_pow_optimisation_enabled_ = enabled;
+         }
+
+         template<typename T> bool expression_generator<T>::cardinal_pow_optimisation_enabled() const
+         {
+            return cardinal_pow_optimisation_enabled_;
+         }
+
+         template<typename T> void expression_generator<T>::set_synthesis_time(double* synthesis_time)
+         {
+            synthesis_time_   = synthesis_time;
+            synthesis_active_ = false;
+         }
+
          template<typename T> bool expression_generator<T>::valid_operator(const details::operator_type& operation, expression_generator<T>::binary_functor_t& bop)
          {
             typename binary_op_map_t::iterator bop_itr = binary_op_map_->find(operation);
@@ -5940,26 +5965,31 @@ namespace Essa::Math{
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (const T& v) const
          {
+            synthesis_timer timer(*this);
             return node_allocator_->template allocate<literal_node_t>(v);
          }
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (const std::string& s) const
          {
+            synthesis_timer timer(*this);
             return node_allocator_->template allocate<string_literal_node_t>(s);
          }
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (std::string& s, range_t& rp) const
          {
+            synthesis_timer timer(*this);
             return node_allocator_->template allocate_rr<string_range_node_t>(s,rp);
          }
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (const std::string& s, range_t& rp) const
          {
+            synthesis_timer timer(*this);
             return node_allocator_->template allocate_tt<const_string_range_node_t>(s,rp);
          }
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (expression_node_ptr branch, range_t& rp) const
          {
+            synthesis_timer timer(*this);
             if (is_generally_string_node(branch))
                return node_allocator_->template allocate_tt<generic_string_range_node_t>(branch,rp);
             else
@@ -6040,6 +6070,7 @@ namespace Essa::Math{
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (const details::operator_type& operation, expression_node_ptr (&branch)[1])
          {
+            synthesis_timer timer(*this);
             if (0 == branch[0])
             {
                return error_node();
@@ -6081,7 +6112,7 @@ namespace Essa::Math{
                      (details::e_divass == operation) ||
                      (details::e_modass == operation)
                    ) &&
-                   parser_->settings().assignment_enabled(operation);
+                   parser_->settings_.assignment_enabled(operation);
          }
 
          template<typename T> bool expression_generator<T>::valid_string_operation(const details::operator_type& operation) const
@@ -6474,6 +6505,7 @@ namespace Essa::Math{
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (const details::operator_type& operation, expression_node_ptr (&branch)[2])
          {
+            synthesis_timer timer(*this);
             if ((0 == branch[0]) || (0 == branch[1]))
             {
                return error_node();
@@ -6522,14 +6554,14 @@ namespace Essa::Math{
             {
                return synthesize_null_expression(operation, branch);
             }
-            else if (is_constpow_operation(operation, branch) && !details::disable_cardinal_pow_optimisation)
+            else if (is_constpow_operation(operation, branch) && cardinal_pow_optimisation_enabled_)
             {
                return cardinal_pow_optimisation(branch);
             }
 
             expression_node_ptr result = error_node();
 
-            if(!details::disable_enhanced_features){
+            if (enhanced_features_enabled_){
                if (synthesize_expression(operation, branch, result))
                {
                   return result;
@@ -6595,6 +6627,7 @@ namespace Essa::Math{
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (const details::operator_type& operation, expression_node_ptr (&branch)[3])
          {
+            synthesis_timer timer(*this);
             if (
                  (0 == branch[0]) ||
                  (0 == branch[1]) ||
@@ -6619,17 +6652,20 @@ namespace Essa::Math{
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (const details::operator_type& operation, expression_node_ptr (&branch)[4])
          {
+            synthesis_timer timer(*this);
             return synthesize_expression<quaternary_node_t,4>(operation,branch);
          }
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (const details::operator_type& operation, expression_node_ptr b0)
          {
+            synthesis_timer timer(*this);
             expression_node_ptr branch[1] = { b0 };
             return (*this)(operation,branch);
          }
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::operator() (const details::operator_type& operation, expression_node_ptr& b0, expression_node_ptr& b1)
          {
+            synthesis_timer timer(*this);
             expression_node_ptr result = error_node();
 
             if ((0 != b0) && (0 != b1))
@@ -6647,6 +6683,7 @@ namespace Essa::Math{
                                                 expression_node_ptr consequent,
                                                 expression_node_ptr alternative) const
          {
+            synthesis_timer timer(*this);
             if(details::disable_string_capabilities){
                return error_node();
             }
@@ -6694,6 +6731,7 @@ namespace Essa::Math{
                                                        expression_node_ptr consequent,
                                                        expression_node_ptr alternative) const
          {
+            synthesis_timer timer(*this);
             if ((0 == condition) || (0 == consequent))
             {
                details::free_node(*node_allocator_, condition  );
@@ -6735,6 +6773,7 @@ namespace Essa::Math{
                                                        expression_node_ptr consequent,
                                                        expression_node_ptr alternative) const
          {
+            synthesis_timer timer(*this);
             if ((0 == condition) || (0 == consequent))
             {
                details::free_node(*node_allocator_, condition  );
@@ -6792,6 +6831,7 @@ namespace Essa::Math{
                                                expression_node_ptr& branch,
                                                const bool break_continue_present) const
          {
+            synthesis_timer timer(*this);
             if (!break_continue_present && details::is_constant_node(condition))
             {
                expression_node_ptr result = error_node();
@@ -6841,6 +6881,7 @@ namespace Essa::Math{
                                                       expression_node_ptr& branch,
                                                       const bool break_continue_present) const
          {
+            synthesis_timer timer(*this);
             if (!break_continue_present && details::is_constant_node(condition))
             {
                if (
@@ -6894,6 +6935,7 @@ namespace Essa::Math{
                                              expression_node_ptr& loop_body,
                                              bool break_continue_present) const
          {
+            synthesis_timer timer(*this);
             if (!break_continue_present && details::is_constant_node(condition))
             {
                expression_node_ptr result = error_node();
@@ -7104,10 +7146,15 @@ namespace Essa::Math{
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::synthesize_uvec_expression(const details::operator_type& operation,
                                                                expression_node_ptr (&branch)[1])
          {
+            typename details::vector_math<T>::unary_t kernel = 0;
+
+            if (parser_->settings_.vector_math_enabled())
+               kernel = details::vector_math<T>::unary(operation);
+
             switch (operation)
             {
                #define case_stmt(op0, op1)                                                   \
-               case op0 : return node_allocator_->template allocate<typename details::unary_vector_node<T,op1<T> > > (operation, branch[0]);
+               case op0 : return node_allocator_->template allocate<typename details::unary_vector_node<T,op1<T> > > (operation, branch[0], kernel);
 
                unary_opr_switch_statements
                #undef case_stmt
@@ -7197,6 +7244,7 @@ namespace Essa::Math{
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::special_function(const details::operator_type& operation, expression_node_ptr (&branch)[3])
          {
+            synthesis_timer timer(*this);
             if (!all_nodes_valid(branch))
                return error_node();
             else if (is_constant_foldable(branch))
@@ -7297,6 +7345,7 @@ namespace Essa::Math{
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::special_function(const details::operator_type& operation, expression_node_ptr (&branch)[4])
          {
+            synthesis_timer timer(*this);
             if (!all_nodes_valid(branch))
                return error_node();
             else if (is_constant_foldable(branch))
@@ -7339,13 +7388,26 @@ namespace Essa::Math{
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::function(ifunction_t* f)
          {
+            synthesis_timer timer(*this);
             typedef typename details::function_N_node<T,ifunction_t,0> function_N_node_t;
-            return node_allocator_->template allocate<function_N_node_t>(f);
+
+            expression_node_ptr result = node_allocator_->template allocate<function_N_node_t>(f);
+
+            // Without arguments a function free of side effects is a constant.
+            if (enhanced_features_enabled_ && !f->has_side_effects())
+            {
+               const T v = result->value();
+               details::free_node(*node_allocator_,result);
+               result = node_allocator_->template allocate<literal_node_t>(v);
+            }
+
+            return result;
          }
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::vararg_function_call(ivararg_function_t* vaf,
                                                          std::vector<expression_node_ptr>& arg_list)
          {
+            synthesis_timer timer(*this);
             if (!all_nodes_valid(arg_list))
             {
                details::free_all_nodes(*node_allocator_,arg_list);
@@ -7365,7 +7427,8 @@ namespace Essa::Math{
             {
                const T v = result->value();
                details::free_node(*node_allocator_,result);
-               result = node_allocator_->template allocate<literal_node_t>(v);
+
+               return node_allocator_->template allocate<literal_node_t>(v);
             }
 
             parser_->state_.activate_side_effect("vararg_function_call()");
@@ -7377,6 +7440,7 @@ namespace Essa::Math{
                                                           std::vector<expression_node_ptr>& arg_list,
                                                           const std::size_t& param_seq_index)
          {
+            synthesis_timer timer(*this);
             if (!all_nodes_valid(arg_list))
             {
                details::free_all_nodes(*node_allocator_,arg_list);
@@ -7431,6 +7495,7 @@ namespace Essa::Math{
                                                          std::vector<expression_node_ptr>& arg_list,
                                                          const std::size_t& param_seq_index)
          {
+            synthesis_timer timer(*this);
             if (!all_nodes_valid(arg_list))
             {
                details::free_all_nodes(*node_allocator_,arg_list);
@@ -7482,7 +7547,8 @@ namespace Essa::Math{
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::return_call(std::vector<expression_node_ptr>& arg_list)
          {
-            if(details::disable_enhanced_features){
+            synthesis_timer timer(*this);
+            if (!enhanced_features_enabled_){
                return error_node();
             }
 
@@ -7517,7 +7583,8 @@ namespace Essa::Math{
                                                     results_context_t* rc,
                                                     bool*& return_invoked)
          {
-            if(details::disable_enhanced_features){
+            synthesis_timer timer(*this);
+            if (!enhanced_features_enabled_){
                return error_node();
             }
 
@@ -7534,6 +7601,7 @@ namespace Essa::Math{
                                                    vector_holder_ptr vector_base,
                                                    expression_node_ptr index)
          {
+            synthesis_timer timer(*this);
             expression_node_ptr result = error_node();
             if (details::is_constant_node(index))
             {
@@ -7588,6 +7656,374 @@ namespace Essa::Math{
             return result;
          }
 
+         template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::share_common_subexpressions(expression_node_ptr root)
+         {
+            subexpression_state state;
+
+            if (!analyse_subexpressions(root, state))
+               return root;
+
+            count_subexpression(root, state);
+
+            bool shared = false;
+
+            for (std::size_t i = 0; i < state.class_list.size(); ++i)
+            {
+               subexpression_class& c = state.class_list[i];
+
+               // A reference costs about as much as a single instruction.
+               c.share = (1 < c.count) && (1 < c.cost);
+               shared |= c.share;
+            }
+
+            if (!shared)
+               return root;
+
+            state.root = static_cast<shared_expression_node_t*>(node_allocator_->template allocate<shared_expression_node_t>());
+
+            share_subexpression(root, state);
+            state.root->set_branch(root);
+
+            return state.root;
+         }
+
+         template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::memoise(expression_node_ptr root)
+         {
+            subexpression_state state;
+
+            if (!analyse_subexpressions(root, state))
+               return root;
+
+            memoise_subexpression(root, std::numeric_limits<std::size_t>::max(), state);
+
+            return root;
+         }
+
+         template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::hoist_loop_invariants(expression_node_ptr root)
+         {
+            if (0 != root)
+               hoist_loop_invariant(root);
+
+            return root;
+         }
+
+         template<typename T> bool expression_generator<T>::analyse_subexpressions(expression_node_ptr root, subexpression_state& state)
+         {
+            if (0 == root)
+               return false;
+
+            // Only trees lowered entirely into bytecode are analysed, the
+            // program then lists all the memory the tree writes.
+            details::bytecode_program<T> program;
+            details::bytecode_builder<T> builder(program);
+
+            std::string key;
+            std::vector<const T*> read_list;
+            std::vector<const T*> write_list;
+            std::size_t cost = 0;
+
+            if (!builder.build(root) || !program.key(key, read_list, write_list, cost))
+               return false;
+
+            state.write_set.insert(write_list.begin(), write_list.end());
+            state.root = 0;
+
+            classify_subexpression(root, state);
+
+            return true;
+         }
+
+         template<typename T> std::size_t expression_generator<T>::classify_subexpression(expression_node_ptr node, subexpression_state& state)
+         {
+            static const std::size_t unshareable = std::numeric_limits<std::size_t>::max();
+
+            typename expression_node_t::noderef_list_t child_list;
+            node->collect_nodes(child_list);
+
+            std::vector<std::size_t> child_class(child_list.size());
+            bool shareable = true;
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               child_class[i] = classify_subexpression(*child_list[i], state);
+               shareable &= (unshareable != child_class[i]);
+            }
+
+            std::size_t result = unshareable;
+
+            if (shareable)
+            {
+               std::deque<variable_node_t>      placeholder_list;
+               std::vector<expression_node_ptr> child(child_list.size());
+               std::size_t child_cost = 0;
+
+               for (std::size_t i = 0; i < child_list.size(); ++i)
+               {
+                  placeholder_list.push_back(variable_node_t(state.class_list[child_class[i]].placeholder, std::string()));
+                  child[i] = *child_list[i];
+                  *child_list[i] = &placeholder_list.back();
+                  child_cost += state.class_list[child_class[i]].cost;
+               }
+
+               details::bytecode_program<T> program;
+               details::bytecode_builder<T> builder(program);
+
+               const bool built = builder.build(node);
+
+               for (std::size_t i = 0; i < child_list.size(); ++i)
+               {
+                  *child_list[i] = child[i];
+               }
+
+               std::string key;
+               std::vector<const T*> read_list;
+               std::vector<const T*> write_list;
+               std::size_t cost = 0;
+
+               shareable = built && program.key(key, read_list, write_list, cost) && write_list.empty();
+
+               for (std::size_t i = 0; shareable && (i < read_list.size()); ++i)
+               {
+                  shareable = (state.write_set.end() == state.write_set.find(read_list[i]));
+               }
+
+               if (shareable)
+               {
+                  const typename std::map<std::string,std::size_t>::const_iterator itr = state.key_map.find(key);
+
+                  if (state.key_map.end() != itr)
+                     result = itr->second;
+                  else
+                  {
+                     subexpression_class c;
+                     c.placeholder = T(0);
+                     c.cost        = child_cost + cost;
+                     c.count       = 0;
+                     c.share       = false;
+                     c.shared      = 0;
+
+                     for (std::size_t i = 0; i < child_list.size(); ++i)
+                     {
+                        const subexpression_class& child_class_entry = state.class_list[child_class[i]];
+
+                        c.read_list.insert(c.read_list.end(), child_class_entry.read_list.begin(), child_class_entry.read_list.end());
+                        read_list.erase(std::remove(read_list.begin(), read_list.end(), &child_class_entry.placeholder), read_list.end());
+                     }
+
+                     c.read_list.insert(c.read_list.end(), read_list.begin(), read_list.end());
+                     std::sort(c.read_list.begin(), c.read_list.end());
+                     c.read_list.erase(std::unique(c.read_list.begin(), c.read_list.end()), c.read_list.end());
+
+                     result = state.class_list.size();
+                     state.class_list.push_back(c);
+                     state.key_map[key] = result;
+                  }
+               }
+            }
+
+            state.class_map[node] = result;
+
+            return result;
+         }
+
+         template<typename T> void expression_generator<T>::count_subexpression(expression_node_ptr node, subexpression_state& state)
+         {
+            const std::size_t id = state.class_map[node];
+
+            // Occurrences inside a repeated subtree go away with it.
+            if ((id < state.class_list.size()) && (1 < ++state.class_list[id].count))
+               return;
+
+            typename expression_node_t::noderef_list_t child_list;
+            node->collect_nodes(child_list);
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               count_subexpression(*child_list[i], state);
+            }
+         }
+
+         template<typename T> void expression_generator<T>::memoise_subexpression(expression_node_ptr& node, const std::size_t parent, subexpression_state& state)
+         {
+            const std::size_t id = state.class_map[node];
+
+            typename expression_node_t::noderef_list_t child_list;
+            node->collect_nodes(child_list);
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               memoise_subexpression(*child_list[i], id, state);
+            }
+
+            if ((id >= state.class_list.size()) || (state.class_list[id].cost < 2))
+               return;
+
+            const subexpression_class& c = state.class_list[id];
+
+            // Whenever the parent reads the same memory, the two always
+            // have to be evaluated together.
+            if (
+                 (parent < state.class_list.size()) &&
+                 (c.read_list.size() == state.class_list[parent].read_list.size())
+               )
+               return;
+
+            node = node_allocator_->template allocate_rc<memo_node_t>(node, c.read_list);
+         }
+
+         template<typename T> void expression_generator<T>::hoist_loop_invariant(expression_node_ptr& node)
+         {
+            typename expression_node_t::noderef_list_t child_list;
+            node->collect_nodes(child_list);
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               hoist_loop_invariant(*child_list[i]);
+            }
+
+            switch (node->type())
+            {
+               case details::expression_node<T>::e_while  :
+               case details::expression_node<T>::e_repeat :
+               case details::expression_node<T>::e_for    : break;
+               default                                    : return;
+            }
+
+            subexpression_state state;
+            state.root = 0;
+
+            if (!loop_write_set(node, state.write_set))
+               return;
+
+            classify_subexpression(node, state);
+
+            bool marked = false;
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               mark_loop_invariant(*child_list[i], state, marked);
+            }
+
+            if (!marked)
+               return;
+
+            state.root = static_cast<shared_expression_node_t*>(node_allocator_->template allocate<shared_expression_node_t>());
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               share_subexpression(*child_list[i], state);
+            }
+
+            state.root->set_branch(node);
+            node = state.root;
+         }
+
+         template<typename T> void expression_generator<T>::mark_loop_invariant(expression_node_ptr node, subexpression_state& state, bool& marked)
+         {
+            const std::size_t id = state.class_map[node];
+
+            // Only the largest invariant subtrees are hoisted, a reference
+            // costing about as much as a single instruction.
+            if ((id < state.class_list.size()) && (1 < state.class_list[id].cost))
+            {
+               state.class_list[id].share = true;
+               marked = true;
+
+               return;
+            }
+
+            typename expression_node_t::noderef_list_t child_list;
+            node->collect_nodes(child_list);
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               mark_loop_invariant(*child_list[i], state, marked);
+            }
+         }
+
+         template<typename T> bool expression_generator<T>::loop_write_set(expression_node_ptr node, std::set<const T*>& write_set)
+         {
+            details::bytecode_program<T> program;
+            details::bytecode_builder<T> builder(program);
+
+            std::string key;
+            std::vector<const T*> read_list;
+            std::vector<const T*> write_list;
+            std::size_t cost = 0;
+
+            if (builder.build(node) && program.key(key, read_list, write_list, cost))
+            {
+               write_set.insert(write_list.begin(), write_list.end());
+
+               return true;
+            }
+
+            // Nodes that write nothing but through their branches, among
+            // them break and continue, and the loops with either or with
+            // runtime checks, which do not lower.
+            switch (node->type())
+            {
+               case details::expression_node<T>::e_conditional :
+               case details::expression_node<T>::e_vararg      :
+               case details::expression_node<T>::e_switch      :
+               case details::expression_node<T>::e_mswitch     :
+               case details::expression_node<T>::e_while       :
+               case details::expression_node<T>::e_repeat      :
+               case details::expression_node<T>::e_for         :
+               case details::expression_node<T>::e_break       :
+               case details::expression_node<T>::e_sharedexpr  : break;
+               default                                         : return false;
+            }
+
+            typename expression_node_t::noderef_list_t child_list;
+            node->collect_nodes(child_list);
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               if (!loop_write_set(*child_list[i], write_set))
+                  return false;
+            }
+
+            return true;
+         }
+
+         template<typename T> void expression_generator<T>::share_subexpression(expression_node_ptr& node, subexpression_state& state)
+         {
+            const std::size_t id = state.class_map[node];
+
+            typename expression_node_t::noderef_list_t child_list;
+
+            if ((id < state.class_list.size()) && state.class_list[id].share)
+            {
+               subexpression_class& c = state.class_list[id];
+
+               if (0 == c.shared)
+               {
+                  node->collect_nodes(child_list);
+
+                  for (std::size_t i = 0; i < child_list.size(); ++i)
+                  {
+                     share_subexpression(*child_list[i], state);
+                  }
+
+                  c.shared = &state.root->share(node);
+               }
+               else
+                  details::free_node(*node_allocator_, node);
+
+               node = node_allocator_->template allocate<shared_reference_node_t>(*c.shared);
+
+               return;
+            }
+
+            node->collect_nodes(child_list);
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               share_subexpression(*child_list[i], state);
+            }
+         }
+
          template<typename T> void expression_generator<T>::lodge_assignment(symbol_type cst, expression_node_ptr node)
          {
             parser_->state_.activate_side_effect("lodge_assignment()");
@@ -8143,7 +8579,7 @@ namespace Essa::Math{
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::cardinal_pow_optimisation(const T& v, const T& c)
          {
-            if(details::disable_cardinal_pow_optimisation)
+            if (!cardinal_pow_optimisation_enabled_)
                return error_node();
             const bool not_recipricol = details::is_true(details::numeric::geq<T>(c, T(0)));
             const unsigned int p = static_cast<unsigned int>(details::numeric::to_int32(details::numeric::abs(c)));
@@ -8166,14 +8602,14 @@ namespace Essa::Math{
 
          template<typename T> bool expression_generator<T>::cardinal_pow_optimisable(const details::operator_type& operation, const T& c) const
          {
-            if(details::disable_cardinal_pow_optimisation)
+            if (!cardinal_pow_optimisation_enabled_)
                return false;
             return (details::e_pow == operation) && (details::is_true(details::numeric::leq<T>(details::numeric::abs(c), T(60)))) && details::numeric::is_integer(c);
          }
 
          template<typename T> expression_generator<T>::expression_node_ptr expression_generator<T>::cardinal_pow_optimisation(expression_node_ptr (&branch)[2])
          {
-            if(details::disable_cardinal_pow_optimisation)
+            if (!cardinal_pow_optimisation_enabled_)
                return error_node();
             const T c = static_cast<details::literal_node<T>*>(branch[1])->value();
             const bool not_recipricol = details::is_true(details::numeric::geq<T>(c, T(0)));
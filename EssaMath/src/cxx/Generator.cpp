@@ -22,9 +22,13 @@ namespace Essa::Math{
 
          bool generator::process(const std::string& str)
          {
-            base_itr_ = str.data();
-            s_itr_    = str.data();
-            s_end_    = str.data() + str.size();
+            // Token values view into source_, so keep our own copy of the
+            // expression for as long as the token list is alive.
+            source_.assign(str);
+
+            base_itr_ = source_.data();
+            s_itr_    = source_.data();
+            s_end_    = source_.data() + source_.size();
 
             eof_token_.set_operator(token_t::e_eof,s_end_,s_end_,base_itr_);
             token_list_.clear();
@@ -0,0 +1,400 @@
+#include "include/Jit.hpp"
+#include "include/ExpressionNodes.hpp"
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) && !defined(_WIN32) && (defined(__unix__) || defined(__APPLE__))
+   #define exprtk_enable_jit
+   #include <sys/mman.h>
+#endif
+
+namespace Essa::Math{
+   namespace details
+   {
+      // x86-64 encodings used by the translation. Registers are numbered
+      // as in the ModRM byte.
+      enum jit_register
+      {
+         e_jit_rax = 0, e_jit_rcx = 1, e_jit_rdx = 2, e_jit_rbx = 3,
+         e_jit_rsi = 6, e_jit_rdi = 7
+      };
+
+      enum jit_sse_opcode
+      {
+         e_jit_movsd_load  = 0x10, e_jit_movsd_store = 0x11,
+         e_jit_ucomisd     = 0x2E, e_jit_xorpd       = 0x57,
+         e_jit_addsd       = 0x58, e_jit_mulsd       = 0x59,
+         e_jit_subsd       = 0x5C, e_jit_divsd       = 0x5E
+      };
+
+      template<typename T> jit_program<T>::jit_program()
+      : base_       (0)
+      , memory_     (0)
+      , memory_size_(0)
+      , function_   (0)
+      {}
+
+      template<typename T> jit_program<T>::~jit_program()
+      {
+         release();
+      }
+
+      template<typename T> bool jit_program<T>::supported()
+      {
+         #ifdef exprtk_enable_jit
+         return std::is_same<T,double>::value;
+         #else
+         return false;
+         #endif
+      }
+
+      template<typename T> bool jit_program<T>::valid() const
+      {
+         return (0 != function_);
+      }
+
+      template<typename T> std::size_t jit_program<T>::code_size() const
+      {
+         return memory_ ? code_.size() : 0;
+      }
+
+      template<typename T> T jit_program<T>::value() const
+      {
+         assert(function_);
+
+         return function_();
+      }
+
+      template<typename T> void jit_program<T>::release()
+      {
+         #ifdef exprtk_enable_jit
+         if (memory_)
+         {
+            munmap(memory_, memory_size_);
+         }
+         #endif
+
+         code_.clear();
+
+         base_        = 0;
+         memory_      = 0;
+         memory_size_ = 0;
+         function_    = 0;
+      }
+
+      template<typename T> void jit_program<T>::emit(const unsigned char byte)
+      {
+         code_.push_back(byte);
+      }
+
+      template<typename T> void jit_program<T>::emit_u32(const uint32_t value)
+      {
+         for (std::size_t i = 0; i < 4; ++i)
+         {
+            emit(static_cast<unsigned char>(value >> (8 * i)));
+         }
+      }
+
+      template<typename T> void jit_program<T>::emit_u64(const uint64_t value)
+      {
+         for (std::size_t i = 0; i < 8; ++i)
+         {
+            emit(static_cast<unsigned char>(value >> (8 * i)));
+         }
+      }
+
+      template<typename T> void jit_program<T>::emit_memory(const unsigned char prefix, const unsigned char opcode,
+                                                             const unsigned char reg, const void* address)
+      {
+         const int64_t displacement = static_cast<int64_t>(reinterpret_cast<uintptr_t>(address)) -
+                                      static_cast<int64_t>(reinterpret_cast<uintptr_t>(base_));
+
+         const bool near = (displacement >= INT32_MIN) && (displacement <= INT32_MAX);
+
+         if (!near)
+         {
+            emit_move_imm(e_jit_rax, reinterpret_cast<uintptr_t>(address));
+         }
+
+         emit(prefix);
+         emit(0x0F);
+         emit(opcode);
+
+         if (near)
+         {
+            // [rbx + disp32]
+            emit(static_cast<unsigned char>(0x80 | (reg << 3) | e_jit_rbx));
+            emit_u32(static_cast<uint32_t>(displacement));
+         }
+         else
+         {
+            // [rax]
+            emit(static_cast<unsigned char>((reg << 3) | e_jit_rax));
+         }
+      }
+
+      template<typename T> void jit_program<T>::emit_load(const void* address)
+      {
+         emit_memory(0xF2, e_jit_movsd_load, 0, address);
+      }
+
+      template<typename T> void jit_program<T>::emit_store(const void* address)
+      {
+         emit_memory(0xF2, e_jit_movsd_store, 0, address);
+      }
+
+      template<typename T> void jit_program<T>::emit_move_imm(const unsigned char reg, const uint64_t value)
+      {
+         // mov reg, imm64
+         emit(0x48);
+         emit(static_cast<unsigned char>(0xB8 + reg));
+         emit_u64(value);
+      }
+
+      template<typename T> void jit_program<T>::emit_call(const uint64_t function)
+      {
+         // call rax
+         emit_move_imm(e_jit_rax, function);
+         emit(0xFF);
+         emit(0xD0);
+      }
+
+      template<typename T> void jit_program<T>::emit_test_true()
+      {
+         // xorpd xmm1, xmm1 ; ucomisd xmm0, xmm1
+         emit(0x66); emit(0x0F); emit(e_jit_xorpd  ); emit(0xC9);
+         emit(0x66); emit(0x0F); emit(e_jit_ucomisd); emit(0xC1);
+      }
+
+      template<typename T> bool jit_program<T>::compile(const program_t& program)
+      {
+         release();
+
+         if (!supported() || program.instruction_list_.empty())
+            return false;
+
+         #ifdef exprtk_enable_jit
+         const std::vector<instruction_t>& instruction_list = program.instruction_list_;
+         const std::size_t count = instruction_list.size();
+
+         base_ = program.register_list_.empty() ?
+                 reinterpret_cast<const unsigned char*>(program.result_) :
+                 reinterpret_cast<const unsigned char*>(&program.register_list_[0]);
+
+         std::vector<bool>        label (count, false);
+         std::vector<std::size_t> offset(count, 0    );
+         std::vector<jump_fixup>  fixup_list;
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            const instruction_t& inst = instruction_list[i];
+
+            if ((program_t::e_jump == inst.op) || (program_t::e_jump_false == inst.op))
+            {
+               label[inst.target] = true;
+            }
+         }
+
+         // push rbx ; mov rbx, base
+         emit(0x53);
+         emit_move_imm(e_jit_rbx, reinterpret_cast<uintptr_t>(base_));
+
+         // Address whose value xmm0 holds, so that an operand produced by the
+         // previous instruction is not loaded again.
+         const T* cached = 0;
+
+         for (std::size_t i = 0; i < count; ++i)
+         {
+            const instruction_t& inst = instruction_list[i];
+
+            offset[i] = code_.size();
+
+            if (label[i])
+            {
+               cached = 0;
+            }
+
+            unsigned char opcode = 0;
+
+            switch (inst.op)
+            {
+               case program_t::e_halt       : if (program.result_ != cached)
+                                                 emit_load(program.result_);
+
+                                              // pop rbx ; ret
+                                              emit(0x5B);
+                                              emit(0xC3);
+                                              cached = 0;
+                                              break;
+
+               case program_t::e_mov        : if (inst.a != cached)
+                                                 emit_load(inst.a);
+
+                                              emit_store(inst.r);
+                                              cached = inst.r;
+                                              break;
+
+               case program_t::e_add        : opcode = e_jit_addsd; break;
+               case program_t::e_sub        : opcode = e_jit_subsd; break;
+               case program_t::e_mul        : opcode = e_jit_mulsd; break;
+               case program_t::e_div        : opcode = e_jit_divsd; break;
+
+               case program_t::e_neg        : if (inst.a != cached)
+                                                 emit_load(inst.a);
+
+                                              // mov rax, sign ; movq xmm1, rax ; xorpd xmm0, xmm1
+                                              emit_move_imm(e_jit_rax, 0x8000000000000000ULL);
+                                              emit(0x66); emit(0x48); emit(0x0F); emit(0x6E); emit(0xC8);
+                                              emit(0x66); emit(0x0F); emit(e_jit_xorpd); emit(0xC1);
+                                              emit_store(inst.r);
+                                              cached = inst.r;
+                                              break;
+
+               case program_t::e_ufunc      : emit_move_imm(e_jit_rdi, reinterpret_cast<uintptr_t>(inst.a));
+                                              emit_call(reinterpret_cast<uintptr_t>(inst.uf));
+                                              emit_store(inst.r);
+                                              cached = inst.r;
+                                              break;
+
+               case program_t::e_bfunc      : emit_move_imm(e_jit_rdi, reinterpret_cast<uintptr_t>(inst.a));
+                                              emit_move_imm(e_jit_rsi, reinterpret_cast<uintptr_t>(inst.b));
+                                              emit_call(reinterpret_cast<uintptr_t>(inst.bf));
+                                              emit_store(inst.r);
+                                              cached = inst.r;
+                                              break;
+
+               case program_t::e_tfunc      : emit_move_imm(e_jit_rdi, reinterpret_cast<uintptr_t>(inst.a));
+                                              emit_move_imm(e_jit_rsi, reinterpret_cast<uintptr_t>(inst.b));
+                                              emit_move_imm(e_jit_rdx, reinterpret_cast<uintptr_t>(inst.c));
+                                              emit_call(reinterpret_cast<uintptr_t>(inst.tf));
+                                              emit_store(inst.r);
+                                              cached = inst.r;
+                                              break;
+
+               case program_t::e_qfunc      : emit_move_imm(e_jit_rdi, reinterpret_cast<uintptr_t>(inst.a));
+                                              emit_move_imm(e_jit_rsi, reinterpret_cast<uintptr_t>(inst.b));
+                                              emit_move_imm(e_jit_rdx, reinterpret_cast<uintptr_t>(inst.c));
+                                              emit_move_imm(e_jit_rcx, reinterpret_cast<uintptr_t>(inst.qop->d));
+                                              emit_call(reinterpret_cast<uintptr_t>(inst.qop->qf));
+                                              emit_store(inst.r);
+                                              cached = inst.r;
+                                              break;
+
+               case program_t::e_jump       : {
+                                                 // jmp rel32
+                                                 emit(0xE9);
+                                                 const jump_fixup fixup = { code_.size(), inst.target };
+                                                 fixup_list.push_back(fixup);
+                                                 emit_u32(0);
+                                              }
+                                              cached = 0;
+                                              break;
+
+               case program_t::e_jump_false : {
+                                                 if (inst.a != cached)
+                                                    emit_load(inst.a);
+
+                                                 emit_test_true();
+
+                                                 // jp +6 ; je rel32, so only an ordered zero jumps
+                                                 emit(0x7A); emit(0x06);
+                                                 emit(0x0F); emit(0x84);
+                                                 const jump_fixup fixup = { code_.size(), inst.target };
+                                                 fixup_list.push_back(fixup);
+                                                 emit_u32(0);
+                                              }
+                                              cached = inst.a;
+                                              break;
+
+               case program_t::e_select     : {
+                                                 if (inst.a != cached)
+                                                    emit_load(inst.a);
+
+                                                 emit_test_true();
+                                                 emit_load(inst.b);
+
+                                                 // jp done ; jne done ; movsd xmm0, c ; done:
+                                                 emit(0x7A); emit(0x00);
+                                                 const std::size_t jp_offset = code_.size();
+                                                 emit(0x75); emit(0x00);
+                                                 const std::size_t jne_offset = code_.size();
+
+                                                 emit_load(inst.c);
+
+                                                 code_[jp_offset  - 1] = static_cast<unsigned char>(code_.size() - jp_offset );
+                                                 code_[jne_offset - 1] = static_cast<unsigned char>(code_.size() - jne_offset);
+
+                                                 emit_store(inst.r);
+                                              }
+                                              cached = inst.r;
+                                              break;
+
+               default                      : // Calls into the tree, user functions and vector operations.
+                                              emit_move_imm(e_jit_rdi, reinterpret_cast<uintptr_t>(&inst));
+                                              emit_call(reinterpret_cast<uintptr_t>(&program_t::execute));
+                                              cached = 0;
+                                              break;
+            }
+
+            if (opcode)
+            {
+               if (inst.a != cached)
+                  emit_load(inst.a);
+
+               emit_memory(0xF2, opcode, 0, inst.b);
+               emit_store(inst.r);
+               cached = inst.r;
+            }
+         }
+
+         for (std::size_t i = 0; i < fixup_list.size(); ++i)
+         {
+            const jump_fixup& fixup = fixup_list[i];
+            const int64_t displacement = static_cast<int64_t>(offset[fixup.target]) -
+                                         static_cast<int64_t>(fixup.offset + 4);
+
+            const uint32_t rel32 = static_cast<uint32_t>(static_cast<int32_t>(displacement));
+
+            std::memcpy(&code_[fixup.offset], &rel32, sizeof(rel32));
+         }
+
+         const std::size_t size = code_.size();
+
+         void* memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+         if (MAP_FAILED == memory)
+         {
+            release();
+            return false;
+         }
+
+         std::memcpy(memory, &code_[0], size);
+
+         memory_      = memory;
+         memory_size_ = size;
+
+         if (0 != mprotect(memory, size, PROT_READ | PROT_EXEC))
+         {
+            release();
+            return false;
+         }
+
+         function_ = reinterpret_cast<function_t>(memory);
+
+         return true;
+         #else
+         return false;
+         #endif
+      }
+
+      template class jit_program<int16_t>;
+      template class jit_program<int32_t>;
+      template class jit_program<int64_t>;
+      template class jit_program<float>;
+      template class jit_program<double>;
+      template class jit_program<long double>;
+      template class jit_program<std::complex<float>>;
+      template class jit_program<std::complex<double>>;
+      template class jit_program<std::complex<long double>>;
+   }
+}
@@ -1,5 +1,8 @@
 #include "include/Lexer.hpp"
 #include "include/Numeric.hpp"
+#include <array>
+#include <cfloat>
+#include <charconv>
 
 namespace Essa::Math{
    namespace details{
@@ -629,25 +632,242 @@ namespace Essa::Math{
          return true;
       }
 
+      /*
+         Fast paths for plain literals: [+-]digits[.digits][(e|E)[+-]digits]
+         for the real types and [+-]digits for the integers. Anything else
+         (suffixes, #inf, b-exponents, out of range values) is left to the
+         hand written parsers above.
+
+         Real literals whose significand fits in the mantissa and whose
+         power of ten is exactly representable are a single correctly
+         rounded multiply or divide (Clinger's fast path), the rest goes
+         through std::from_chars. Both round to nearest like strtod.
+      */
+      static inline bool is_digit_char(const char_t c)
+      {
+         return static_cast<unsigned int>(c - '0') < 10;
+      }
+
       template <typename T>
-      bool string_to_real(const std::string& s, T& t)
+      struct exact_pow10
+      {
+         static constexpr int digits = std::numeric_limits<T>::digits;
+
+         // Largest e with 5^e < 2^digits, i.e. 10^e is exact in T.
+         static constexpr int max_exponent = static_cast<int>((digits - 1) / 2.321928094887362);
+
+         static constexpr _uint64_t max_mantissa = (digits >= 64) ? ~_uint64_t(0) : (_uint64_t(1) << digits);
+
+         // float/double arithmetic is evaluated in extended precision on x87.
+         static constexpr bool enabled = (0 == FLT_EVAL_METHOD) || (sizeof(T) >= sizeof(long double));
+
+         static constexpr std::array<T, max_exponent + 1> make_table()
+         {
+            std::array<T, max_exponent + 1> table {};
+
+            table[0] = T(1);
+
+            for (int i = 1; i <= max_exponent; ++i)
+            {
+               table[i] = table[i - 1] * T(10);
+            }
+
+            return table;
+         }
+
+         static constexpr std::array<T, max_exponent + 1> table = make_table();
+      };
+
+      template <typename T>
+      static bool fast_string_to_real(char_cptr begin, const char_cptr end, T& t, numeric::details::real_type_tag)
+      {
+         static const std::size_t max_digits = 19;
+
+         char_cptr itr = begin;
+
+         const bool negative = ('-' == (*itr));
+
+         if ('+' == (*itr))
+            begin = ++itr;
+         else if (negative)
+            ++itr;
+
+         const char_cptr digits_begin = itr;
+
+         while ((end != itr) && ('0' == (*itr)))
+            ++itr;
+
+         const char_cptr int_begin = itr;
+
+         _uint64_t mantissa = 0;
+
+         while ((end != itr) && is_digit_char(*itr))
+         {
+            mantissa = mantissa * 10 + static_cast<unsigned int>(*itr - '0');
+            ++itr;
+         }
+
+         std::size_t digit_count = static_cast<std::size_t>(std::distance(int_begin, itr));
+         int         exponent    = 0;
+         bool        instate     = (digits_begin != itr);
+
+         if ((end != itr) && ('.' == (*itr)))
+         {
+            const char_cptr frac_begin = ++itr;
+
+            while ((end != itr) && is_digit_char(*itr))
+            {
+               mantissa = mantissa * 10 + static_cast<unsigned int>(*itr - '0');
+               ++itr;
+            }
+
+            const std::size_t frac_digits = static_cast<std::size_t>(std::distance(frac_begin, itr));
+
+            digit_count += frac_digits;
+            exponent    -= static_cast<int>(frac_digits);
+            instate     |= (0 != frac_digits);
+         }
+
+         if (!instate)
+            return false;
+
+         if ((end != itr) && (('e' == (*itr)) || ('E' == (*itr))))
+         {
+            if (end == ++itr)
+               return false;
+
+            const bool exp_negative = ('-' == (*itr));
+
+            if (exp_negative || ('+' == (*itr)))
+            {
+               if (end == ++itr)
+                  return false;
+            }
+
+            int exp = 0;
+
+            while ((end != itr) && is_digit_char(*itr))
+            {
+               if (exp < 100000)
+                  exp = exp * 10 + (*itr - '0');
+
+               ++itr;
+            }
+
+            if ((end != itr) || !is_digit_char(*(itr - 1)))
+               return false;
+
+            exponent += exp_negative ? -exp : exp;
+         }
+         else if (end != itr)
+            return false;
+
+         typedef exact_pow10<T> pow10_t;
+
+         if (
+              pow10_t::enabled                                &&
+              (digit_count <= max_digits)                     &&
+              (mantissa    <= pow10_t::max_mantissa)          &&
+              (std::abs(exponent) <= pow10_t::max_exponent)
+            )
+         {
+            T d = static_cast<T>(mantissa);
+
+            if (exponent < 0)
+               d /= pow10_t::table[-exponent];
+            else if (exponent > 0)
+               d *= pow10_t::table[exponent];
+
+            t = negative ? -d : d;
+
+            return true;
+         }
+
+         const std::from_chars_result result = std::from_chars(begin, end, t, std::chars_format::general);
+
+         return (std::errc() == result.ec) && (end == result.ptr);
+      }
+
+      template <typename T>
+      static bool fast_string_to_real(const char_cptr begin, const char_cptr end, T& t, numeric::details::complex_type_tag)
+      {
+         typename T::value_type v;
+
+         if (!fast_string_to_real(begin, end, v, numeric::details::real_type_tag()))
+            return false;
+
+         t = T(v);
+         return true;
+      }
+
+      template <typename T>
+      static bool fast_string_to_real(char_cptr begin, const char_cptr end, T& t, numeric::details::int_type_tag)
+      {
+         char_cptr itr = begin;
+
+         const bool negative = ('-' == (*itr));
+
+         if ('+' == (*itr))
+            begin = ++itr;
+         else if (negative)
+            ++itr;
+
+         if (end == itr)
+            return false;
+
+         const std::size_t length = static_cast<std::size_t>(std::distance(itr, end));
+
+         if (length > static_cast<std::size_t>(std::numeric_limits<T>::digits10))
+         {
+            if ('-' == (*itr))
+               return false;
+
+            const std::from_chars_result result = std::from_chars(begin, end, t);
+
+            return (std::errc() == result.ec) && (end == result.ptr);
+         }
+
+         T d = T(0);
+
+         for ( ; end != itr; ++itr)
+         {
+            const unsigned int digit = static_cast<unsigned int>(*itr - '0');
+
+            if (digit > 9)
+               return false;
+
+            d = static_cast<T>(d * 10 + digit);
+         }
+
+         t = negative ? static_cast<T>(-d) : d;
+
+         return true;
+      }
+
+      template <typename T>
+      bool string_to_real(std::string_view s, T& t)
       {
          const typename numeric::details::number_type<T>::type num_type;
 
          char_cptr begin = s.data();
          char_cptr end   = s.data() + s.size();
 
+         if (begin == end)
+            return false;
+         else if (fast_string_to_real(begin, end, t, num_type))
+            return true;
+
          return string_to_real(begin, end, t, num_type);
       }
-      template bool string_to_real(const std::string&, int16_t&);
-      template bool string_to_real(const std::string&, int32_t&);
-      template bool string_to_real(const std::string&, int64_t&);
-      template bool string_to_real(const std::string&, float&);
-      template bool string_to_real(const std::string&, double&);
-      template bool string_to_real(const std::string&, long double&);
-      template bool string_to_real(const std::string&, std::complex<float>&);
-      template bool string_to_real(const std::string&, std::complex<double>&);
-      template bool string_to_real(const std::string&, std::complex<long double>&);
+      template bool string_to_real(std::string_view, int16_t&);
+      template bool string_to_real(std::string_view, int32_t&);
+      template bool string_to_real(std::string_view, int64_t&);
+      template bool string_to_real(std::string_view, float&);
+      template bool string_to_real(std::string_view, double&);
+      template bool string_to_real(std::string_view, long double&);
+      template bool string_to_real(std::string_view, std::complex<float>&);
+      template bool string_to_real(std::string_view, std::complex<double>&);
+      template bool string_to_real(std::string_view, std::complex<long double>&);
 
    }
       loop_runtime_check::loop_runtime_check()
@@ -667,6 +887,66 @@ namespace Essa::Math{
 
    namespace lexer
    {
+         token_string& token_string::operator=(const std::string& s)
+         {
+            owned_ = s;
+            view_  = false;
+            return (*this);
+         }
+
+         token_string& token_string::operator=(const char* s)
+         {
+            owned_ = s;
+            view_  = false;
+            return (*this);
+         }
+
+         token_string& token_string::operator=(const char c)
+         {
+            owned_.assign(1,c);
+            view_  = false;
+            return (*this);
+         }
+
+         void token_string::detach()
+         {
+            if (view_)
+            {
+               owned_.assign(begin_,size_);
+               view_ = false;
+            }
+         }
+
+         bool operator==(const token_string& s0, std::string_view s1)
+         {
+            return s0.view() == s1;
+         }
+
+         bool operator!=(const token_string& s0, std::string_view s1)
+         {
+            return s0.view() != s1;
+         }
+
+         std::string operator+(const std::string& s0, const token_string& s1)
+         {
+            return std::string(s0).append(s1.data(),s1.size());
+         }
+
+         std::string operator+(const char* s0, const token_string& s1)
+         {
+            return std::string(s0).append(s1.data(),s1.size());
+         }
+
+         std::string operator+(const token_string& s0, const std::string& s1)
+         {
+            return s0.str().append(s1);
+         }
+
+         std::string operator+(const token_string& s0, const char* s1)
+         {
+            return s0.str().append(s1);
+         }
+
          token::token()
          : type(e_none)
          , value("")
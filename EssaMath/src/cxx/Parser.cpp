@@ -33,6 +33,7 @@ namespace Essa::Math{
          type t;
          t.mode         = mode;
          t.token        = tk;
+         t.token.value.detach();
          t.diagnostic   = diagnostic;
          t.src_location = src_location;
          exprtk_debug(("%s\n",diagnostic .c_str()));
@@ -1013,13 +1014,15 @@ template<typename T> parser<T>::scope_element::scope_element()
          }
 
          template<typename T> const std::size_t parser<T>::settings_store::compile_all_opts =
-                                     e_replacer          +
-                                     e_joiner            +
-                                     e_numeric_check     +
-                                     e_bracket_check     +
-                                     e_sequence_check    +
-                                     e_commutative_check +
-                                     e_strength_reduction;
+                                     e_replacer           +
+                                     e_joiner             +
+                                     e_numeric_check      +
+                                     e_bracket_check      +
+                                     e_sequence_check     +
+                                     e_commutative_check  +
+                                     e_strength_reduction +
+                                     e_common_subexpr     +
+                                     e_loop_invariant;
 
          template<typename T> parser<T>::settings_store::settings_store(const std::size_t compile_options)
          : max_stack_depth_(400)
@@ -1143,6 +1146,10 @@ template<typename T> parser<T>::scope_element::scope_element()
          template<typename T> bool parser<T>::settings_store::vardef_disabled            () const { return disable_vardef_;            }
          template<typename T> bool parser<T>::settings_store::rsrvd_sym_usr_disabled     () const { return disable_rsrvd_sym_usr_;     }
          template<typename T> bool parser<T>::settings_store::zero_return_disabled       () const { return disable_zero_return_;       }
+         template<typename T> bool parser<T>::settings_store::common_subexpr_enabled     () const { return enable_common_subexpr_;     }
+         template<typename T> bool parser<T>::settings_store::memoise_enabled            () const { return enable_memoise_;            }
+         template<typename T> bool parser<T>::settings_store::vector_math_enabled        () const { return enable_vector_math_;        }
+         template<typename T> bool parser<T>::settings_store::loop_invariant_enabled     () const { return enable_loop_invariant_;     }
 
          template<typename T> bool parser<T>::settings_store::function_enabled(const std::string& function_name) const
          {
@@ -1466,6 +1473,10 @@ template<typename T> parser<T>::scope_element::scope_element()
             disable_vardef_            = (compile_options & e_disable_vardef      ) == e_disable_vardef;
             disable_rsrvd_sym_usr_     = (compile_options & e_disable_usr_on_rsrvd) == e_disable_usr_on_rsrvd;
             disable_zero_return_       = (compile_options & e_disable_zero_return ) == e_disable_zero_return;
+            enable_common_subexpr_     = (compile_options & e_common_subexpr      ) == e_common_subexpr;
+            enable_memoise_            = (compile_options & e_memoise             ) == e_memoise;
+            enable_vector_math_        = (compile_options & e_vector_math         ) == e_vector_math;
+            enable_loop_invariant_     = (compile_options & e_loop_invariant      ) == e_loop_invariant;
          }
 
          template<typename T> std::string parser<T>::settings_store::assign_opr_to_string(details::operator_type opr) const
@@ -1542,6 +1553,7 @@ template<typename T> parser<T>::scope_element::scope_element()
       , operator_joiner_2_(2)
       , operator_joiner_3_(3)
       , loop_runtime_check_(0)
+      , compile_stats_(0)
       {
          init_precompilation();
 
@@ -1560,6 +1572,9 @@ template<typename T> parser<T>::scope_element::scope_element()
          expression_generator_.set_sf3m(sf3_map_);
          expression_generator_.set_sf4m(sf4_map_);
          expression_generator_.set_strength_reduction_state(settings_.strength_reduction_enabled());
+         expression_generator_.set_enhanced_features_state(true);
+         expression_generator_.set_cardinal_pow_optimisation_state(true);
+         expression_generator_.set_synthesis_time(0);
 
         settings_.disable_all_assignment_ops();
         settings_.disable_all_control_structures();
@@ -1694,113 +1709,195 @@ template<typename T> parser<T>::scope_element::scope_element()
 
       template<typename T> bool parser<T>::compile(const std::string& expression_string, expression<T>& expr)
       {
-         for(size_t i = 0; i < 2; i++){
-            if(i == 0){
-               details::disable_enhanced_features = false;
-               details::disable_cardinal_pow_optimisation = false;
-            }else{
-               details::disable_enhanced_features = true;
-               details::disable_cardinal_pow_optimisation = true;
-            }
+         if (compile_stats_)
+         {
+            *compile_stats_ = compile_stats();
+         }
 
-            state_          .reset();
-            error_list_     .clear();
-            brkcnt_list_    .clear();
-            synthesis_error_.clear();
-            sem_            .cleanup();
+         phase_timer total_timer(phase_time(&compile_stats::total_time));
 
-            return_cleanup();
+         if (!compile_tree(expression_string, expr, false))
+         {
+            return false;
+         }
 
-            expression_generator_.set_allocator(node_allocator_);
+         if (!display_settings_)
+         {
+            display_settings_ = std::make_shared<const settings_t>(settings_);
+         }
+
+         const std::shared_ptr<const settings_t> display_settings = display_settings_;
 
-            if (expression_string.empty())
+         expr.set_display_builder(
+            [display_settings, expression_string](expression<T>& display) -> bool
             {
-               set_error(
-                  make_error(parser_error::e_syntax,
-                           "ERR001 - Empty expression!",
-                           exprtk_error_location));
+               parser<T> display_parser(*display_settings);
+               return display_parser.compile_tree(expression_string, display, true);
+            });
 
-               return false;
-            }
+         if (compile_stats_)
+         {
+            phase_timer display_timer(phase_time(&compile_stats::display_time));
+            expr.build_display_tree();
+         }
+
+         return true;
+      }
+
+      template<typename T> bool parser<T>::compile_tree(const std::string& expression_string, expression<T>& expr, const bool display_tree)
+      {
+         expression_generator_.set_strength_reduction_state(settings_.strength_reduction_enabled());
+         expression_generator_.set_enhanced_features_state(!display_tree);
+         expression_generator_.set_cardinal_pow_optimisation_state(!display_tree);
+
+         state_          .reset();
+         error_list_     .clear();
+         brkcnt_list_    .clear();
+         synthesis_error_.clear();
+         sem_            .cleanup();
+
+         return_cleanup();
+
+         expression_generator_.set_allocator(node_allocator_);
+
+         if (expression_string.empty())
+         {
+            set_error(
+               make_error(parser_error::e_syntax,
+                        "ERR001 - Empty expression!",
+                        exprtk_error_location));
+
+            return false;
+         }
+
+         const std::size_t allocated_bytes = node_allocator_.allocated_bytes();
+
+         bool lexer_result = false;
+
+         {
+            phase_timer timer(phase_time(&compile_stats::lexer_time));
+            lexer_result = init(expression_string);
+         }
+
+         if (!lexer_result)
+         {
+            process_lexer_errors();
+            return false;
+         }
+
+         if (lexer().empty())
+         {
+            set_error(
+               make_error(parser_error::e_syntax,
+                        "ERR002 - Empty expression!",
+                        exprtk_error_location));
+
+            return false;
+         }
+
+         bool assembly_result = false;
 
-            if (!init(expression_string))
+         {
+            phase_timer timer(phase_time(&compile_stats::assembly_time));
+            assembly_result = run_assemblies();
+         }
+
+         if (!assembly_result)
+         {
+            return false;
+         }
+
+         if (compile_stats_)
+         {
+            compile_stats_->token_count = lexer().size();
+         }
+
+         symtab_store_.symtab_list_ = expr.get_symbol_table_list();
+         dec_.clear();
+
+         lexer().begin();
+
+         next_token();
+
+         expression_node_ptr e = 0;
+
+         {
+            phase_timer timer(phase_time(&compile_stats::parse_time));
+            e = parse_corpus();
+         }
+
+         if (compile_stats_)
+         {
+            compile_stats_->bytes_allocated = node_allocator_.allocated_bytes() - allocated_bytes;
+         }
+
+         if ((0 != e) && (token_t::e_eof == current_token().type))
+         {
+            bool* retinvk_ptr = 0;
+
+            // The display tree mirrors the expression as written.
+            if (settings_.loop_invariant_enabled() && !display_tree)
             {
-               process_lexer_errors();
-               return false;
+               phase_timer timer(phase_time(&compile_stats::hoist_time));
+               e = expression_generator_.hoist_loop_invariants(e);
             }
 
-            if (lexer().empty())
+            if (settings_.memoise_enabled() && !display_tree)
             {
-               set_error(
-                  make_error(parser_error::e_syntax,
-                           "ERR002 - Empty expression!",
-                           exprtk_error_location));
-
-               return false;
+               phase_timer timer(phase_time(&compile_stats::memo_time));
+               e = expression_generator_.memoise(e);
             }
 
-            if (!run_assemblies())
+            if (settings_.common_subexpr_enabled() && !display_tree)
             {
-               return false;
+               phase_timer timer(phase_time(&compile_stats::cse_time));
+               e = expression_generator_.share_common_subexpressions(e);
             }
 
-            symtab_store_.symtab_list_ = expr.get_symbol_table_list();
-            dec_.clear();
-
-            lexer().begin();
+            if (state_.return_stmt_present)
+            {
+               dec_.return_present_ = true;
 
-            next_token();
+               e = expression_generator_
+                     .return_envelope(e, results_context_, retinvk_ptr);
+            }
 
-            expression_node_ptr e = parse_corpus();
+            expr.set_expression(e);
+            expr.set_retinvk(retinvk_ptr);
+            expr.set_vector_math(settings_.vector_math_enabled());
 
-            if ((0 != e) && (token_t::e_eof == current_token().type))
+            if (compile_stats_)
             {
-               bool* retinvk_ptr = 0;
-
-               if (state_.return_stmt_present)
-               {
-                  dec_.return_present_ = true;
+               collect_node_stats(e);
+            }
 
-                  e = expression_generator_
-                        .return_envelope(e, results_context_, retinvk_ptr);
-               }
+            register_local_vars(expr);
+            register_return_results(expr);
 
-               if(i == 0){
-                  expr.set_expression(e);
-                  expr.set_retinvk(retinvk_ptr);
-               }else{
-                  expr.set_unoptimized_expr(e);
-               }
-            }
-            else
+            return !(!expr);
+         }
+         else
+         {
+            if (error_list_.empty())
             {
-               if (error_list_.empty())
-               {
-                  set_error(
-                     make_error(parser_error::e_syntax,
-                              current_token(),
-                              "ERR003 - Invalid expression encountered",
-                              exprtk_error_location));
-               }
+               set_error(
+                  make_error(parser_error::e_syntax,
+                           current_token(),
+                           "ERR003 - Invalid expression encountered",
+                           exprtk_error_location));
+            }
 
-               if ((0 != e) && branch_deletable(e))
-               {
-                  destroy_node(e);
-               }
+            if ((0 != e) && branch_deletable(e))
+            {
+               destroy_node(e);
+            }
 
-               dec_.clear    ();
-               sem_.cleanup  ();
-               return_cleanup();
+            dec_.clear    ();
+            sem_.cleanup  ();
+            return_cleanup();
 
-               return false;
-            }
+            return false;
          }
-         
-         register_local_vars(expr);
-         register_return_results(expr);
-         details::disable_enhanced_features = false;
-         details::disable_cardinal_pow_optimisation = false;
-         return !(!expr);
       }
 
       template<typename T> parser<T>::expression_t parser<T>::compile(const std::string& expression_string, parser<T>::symbol_table_t& symtab)
@@ -1850,106 +1947,93 @@ template<typename T> parser<T>::scope_element::scope_element()
 
       template<typename T> bool parser<T>::run_assemblies()
       {
-         if (settings_.commutative_check_enabled())
-         {
-            helper_assembly_.run_inserters(lexer());
-         }
-
-         if (settings_.joiner_enabled())
-         {
-            helper_assembly_.run_joiners(lexer());
-         }
+         const bool run_scanners =
+            settings_.numeric_check_enabled () ||
+            settings_.bracket_check_enabled () ||
+            settings_.sequence_check_enabled();
 
-         if (settings_.replacer_enabled())
+         if (!helper_assembly_.run_assembly(lexer(),
+                                            settings_.commutative_check_enabled(),
+                                            settings_.joiner_enabled(),
+                                            settings_.replacer_enabled(),
+                                            run_scanners))
          {
-            helper_assembly_.run_modifiers(lexer());
-         }
-
-         if (
-              settings_.numeric_check_enabled () ||
-              settings_.bracket_check_enabled () ||
-              settings_.sequence_check_enabled()
-            )
-         {
-            if (!helper_assembly_.run_scanners(lexer()))
+            if (helper_assembly_.error_token_scanner)
             {
-               if (helper_assembly_.error_token_scanner)
-               {
-                  lexer::helper::bracket_checker*            bracket_checker_ptr     = 0;
-                  lexer::helper::numeric_checker<T>*         numeric_checker_ptr     = 0;
-                  lexer::helper::sequence_validator*         sequence_validator_ptr  = 0;
-                  lexer::helper::sequence_validator_3tokens* sequence_validator3_ptr = 0;
+               lexer::helper::bracket_checker*            bracket_checker_ptr     = 0;
+               lexer::helper::numeric_checker<T>*         numeric_checker_ptr     = 0;
+               lexer::helper::sequence_validator*         sequence_validator_ptr  = 0;
+               lexer::helper::sequence_validator_3tokens* sequence_validator3_ptr = 0;
 
-                  if (0 != (bracket_checker_ptr = dynamic_cast<lexer::helper::bracket_checker*>(helper_assembly_.error_token_scanner)))
+               if (0 != (bracket_checker_ptr = dynamic_cast<lexer::helper::bracket_checker*>(helper_assembly_.error_token_scanner)))
+               {
+                  set_error(
+                     make_error(parser_error::e_token,
+                                bracket_checker_ptr->error_token(),
+                                "ERR005 - Mismatched brackets: '" + bracket_checker_ptr->error_token().value + "'",
+                                exprtk_error_location));
+               }
+               else if (0 != (numeric_checker_ptr = dynamic_cast<lexer::helper::numeric_checker<T>*>(helper_assembly_.error_token_scanner)))
+               {
+                  for (std::size_t i = 0; i < numeric_checker_ptr->error_count(); ++i)
                   {
+                     lexer::token error_token = lexer()[numeric_checker_ptr->error_index(i)];
+
                      set_error(
                         make_error(parser_error::e_token,
-                                   bracket_checker_ptr->error_token(),
-                                   "ERR005 - Mismatched brackets: '" + bracket_checker_ptr->error_token().value + "'",
+                                   error_token,
+                                   "ERR006 - Invalid numeric token: '" + error_token.value + "'",
                                    exprtk_error_location));
                   }
-                  else if (0 != (numeric_checker_ptr = dynamic_cast<lexer::helper::numeric_checker<T>*>(helper_assembly_.error_token_scanner)))
-                  {
-                     for (std::size_t i = 0; i < numeric_checker_ptr->error_count(); ++i)
-                     {
-                        lexer::token error_token = lexer()[numeric_checker_ptr->error_index(i)];
-
-                        set_error(
-                           make_error(parser_error::e_token,
-                                      error_token,
-                                      "ERR006 - Invalid numeric token: '" + error_token.value + "'",
-                                      exprtk_error_location));
-                     }
 
-                     if (numeric_checker_ptr->error_count())
-                     {
-                        numeric_checker_ptr->clear_errors();
-                     }
+                  if (numeric_checker_ptr->error_count())
+                  {
+                     numeric_checker_ptr->clear_errors();
                   }
-                  else if (0 != (sequence_validator_ptr = dynamic_cast<lexer::helper::sequence_validator*>(helper_assembly_.error_token_scanner)))
+               }
+               else if (0 != (sequence_validator_ptr = dynamic_cast<lexer::helper::sequence_validator*>(helper_assembly_.error_token_scanner)))
+               {
+                  for (std::size_t i = 0; i < sequence_validator_ptr->error_count(); ++i)
                   {
-                     for (std::size_t i = 0; i < sequence_validator_ptr->error_count(); ++i)
-                     {
-                        std::pair<lexer::token,lexer::token> error_token = sequence_validator_ptr->error(i);
+                     std::pair<lexer::token,lexer::token> error_token = sequence_validator_ptr->error(i);
 
-                        set_error(
-                           make_error(parser_error::e_token,
-                                      error_token.first,
-                                      "ERR007 - Invalid token sequence: '" +
-                                      error_token.first.value  + "' and '" +
-                                      error_token.second.value + "'",
-                                      exprtk_error_location));
-                     }
+                     set_error(
+                        make_error(parser_error::e_token,
+                                   error_token.first,
+                                   "ERR007 - Invalid token sequence: '" +
+                                   error_token.first.value  + "' and '" +
+                                   error_token.second.value + "'",
+                                   exprtk_error_location));
+                  }
 
-                     if (sequence_validator_ptr->error_count())
-                     {
-                        sequence_validator_ptr->clear_errors();
-                     }
+                  if (sequence_validator_ptr->error_count())
+                  {
+                     sequence_validator_ptr->clear_errors();
                   }
-                  else if (0 != (sequence_validator3_ptr = dynamic_cast<lexer::helper::sequence_validator_3tokens*>(helper_assembly_.error_token_scanner)))
+               }
+               else if (0 != (sequence_validator3_ptr = dynamic_cast<lexer::helper::sequence_validator_3tokens*>(helper_assembly_.error_token_scanner)))
+               {
+                  for (std::size_t i = 0; i < sequence_validator3_ptr->error_count(); ++i)
                   {
-                     for (std::size_t i = 0; i < sequence_validator3_ptr->error_count(); ++i)
-                     {
-                        std::pair<lexer::token,lexer::token> error_token = sequence_validator3_ptr->error(i);
+                     std::pair<lexer::token,lexer::token> error_token = sequence_validator3_ptr->error(i);
 
-                        set_error(
-                           make_error(parser_error::e_token,
-                                      error_token.first,
-                                      "ERR008 - Invalid token sequence: '" +
-                                      error_token.first.value  + "' and '" +
-                                      error_token.second.value + "'",
-                                      exprtk_error_location));
-                     }
+                     set_error(
+                        make_error(parser_error::e_token,
+                                   error_token.first,
+                                   "ERR008 - Invalid token sequence: '" +
+                                   error_token.first.value  + "' and '" +
+                                   error_token.second.value + "'",
+                                   exprtk_error_location));
+                  }
 
-                     if (sequence_validator3_ptr->error_count())
-                     {
-                        sequence_validator3_ptr->clear_errors();
-                     }
+                  if (sequence_validator3_ptr->error_count())
+                  {
+                     sequence_validator3_ptr->clear_errors();
                   }
                }
-
-               return false;
             }
+
+            return false;
          }
 
          return true;
@@ -2039,6 +2123,52 @@ template<typename T> parser<T>::scope_element::scope_element()
          loop_runtime_check_ = loop_runtime_check_ptr(0);
       }
 
+      template<typename T> void parser<T>::register_compile_stats(compile_stats& stats)
+      {
+         compile_stats_ = &stats;
+         expression_generator_.set_synthesis_time(&stats.synthesis_time);
+      }
+
+      template<typename T> void parser<T>::clear_compile_stats()
+      {
+         compile_stats_ = 0;
+         expression_generator_.set_synthesis_time(0);
+      }
+
+      template<typename T> double* parser<T>::phase_time(double compile_stats::* phase)
+      {
+         return compile_stats_ ? &(compile_stats_->*phase) : 0;
+      }
+
+      template<typename T> void parser<T>::collect_node_stats(expression_node_ptr root)
+      {
+         typedef typename expression_node_t::noderef_list_t noderef_list_t;
+
+         std::deque<expression_node_ptr> node_list;
+         noderef_list_t child_list;
+
+         node_list.push_back(root);
+         compile_stats_->node_depth = root->node_depth();
+
+         while (!node_list.empty())
+         {
+            expression_node_ptr node = node_list.front();
+            node_list.pop_front();
+
+            ++compile_stats_->node_count;
+            ++compile_stats_->node_type_count[node->type()];
+
+            child_list.clear();
+            node->collect_nodes(child_list);
+
+            for (std::size_t i = 0; i < child_list.size(); ++i)
+            {
+               if (*child_list[i])
+                  node_list.push_back(*child_list[i]);
+            }
+         }
+      }
+
       template <typename T> bool parser<T>::valid_base_operation(const std::string& symbol) const
       {
          const std::size_t length = symbol.size();
@@ -2112,7 +2242,7 @@ template<typename T> parser<T>::scope_element::scope_element()
                        depth.c_str(),
                        ct_str.c_str(),
                        static_cast<unsigned int>(ct_pos),
-                       current_token().value.c_str(),
+                       current_token().value.str().c_str(),
                        static_cast<unsigned int>(current_token().position),
                        static_cast<unsigned int>(state_.stack_depth)));
       }
@@ -6603,7 +6733,9 @@ template<typename T> parser<T>::scope_element::scope_element()
       template<typename T> void parser<T>::lodge_immutable_symbol(const lexer::token& token, const interval_t interval)
       {
          immutable_memory_map_.add_interval(interval);
-         immutable_symtok_map_[interval] = token;
+         token_t& symtok = immutable_symtok_map_[interval];
+         symtok = token;
+         symtok.value.detach();
       }
 
       template<typename T> parser<T>::expression_node_ptr parser<T>::parse_symtab_symbol()
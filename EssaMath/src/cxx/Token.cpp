@@ -99,6 +99,11 @@ namespace Essa::Math{
             return false;
          }
 
+         std::size_t token_scanner::stride() const
+         {
+            return stride_;
+         }
+
          std::size_t token_modifier::process(generator& g)
          {
             std::size_t changes = 0;
@@ -189,10 +194,20 @@ namespace Essa::Math{
             return changes;
          }
 
+         std::size_t token_inserter::stride() const
+         {
+            return stride_;
+         }
+
         token_joiner::token_joiner(const std::size_t& stride)
          : stride_(stride)
          {}
 
+         std::size_t token_joiner::stride() const
+         {
+            return stride_;
+         }
+
          std::size_t token_joiner::process(generator& g)
          {
             if (g.token_list_.empty())
@@ -303,7 +318,7 @@ namespace Essa::Math{
                       static_cast<int>(i),
                       static_cast<int>(t.position),
                       t.to_str(t.type).c_str(),
-                      t.value.c_str());
+                      t.value.str().c_str());
             }
          }
 
@@ -745,6 +760,11 @@ namespace Essa::Math{
                return error_list_.empty();
             }
 
+            void sequence_validator::reset()
+            {
+               error_list_.clear();
+            }
+
             bool sequence_validator::operator() (const lexer::token& t0, const lexer::token& t1)
             {
                const set_t::value_type p = std::make_pair(t0.type,t1.type);
@@ -890,6 +910,11 @@ namespace Essa::Math{
                return error_list_.empty();
             }
 
+            void sequence_validator_3tokens::reset()
+            {
+               error_list_.clear();
+            }
+
             bool sequence_validator_3tokens::operator() (const lexer::token& t0, const lexer::token& t1, const lexer::token& t2)
             {
                const set_t::value_type p = std::make_pair(t0.type,std::make_pair(t1.type,t2.type));
@@ -930,6 +955,200 @@ namespace Essa::Math{
                invalid_comb_.insert(std::make_pair(t0,std::make_pair(t1,t2)));
             }
 
+            assembly_pipeline::assembly_pipeline(token_list_t& output)
+            : output_(output)
+            {}
+
+            void assembly_pipeline::add_inserter(token_inserter* inserter)
+            {
+               stage s;
+               s.type   = e_inserter;
+               s.helper = inserter;
+               s.stride = inserter->stride();
+               stage_list_.push_back(s);
+            }
+
+            void assembly_pipeline::add_joiner(token_joiner* joiner)
+            {
+               stage s;
+               s.type   = e_joiner;
+               s.helper = joiner;
+               s.stride = joiner->stride();
+               stage_list_.push_back(s);
+            }
+
+            void assembly_pipeline::add_modifier(token_modifier* modifier)
+            {
+               stage s;
+               s.type   = e_modifier;
+               s.helper = modifier;
+               s.stride = 1;
+               stage_list_.push_back(s);
+            }
+
+            void assembly_pipeline::add_scanner(token_scanner* scanner)
+            {
+               scanner_list_  .push_back(scanner);
+               scanner_active_.push_back(true   );
+            }
+
+            void assembly_pipeline::process(generator& g)
+            {
+               output_.clear();
+               output_.reserve(g.token_list_.size());
+
+               for (std::size_t i = 0; i < g.token_list_.size(); ++i)
+               {
+                  push(0, g.token_list_[i]);
+               }
+
+               flush(0);
+
+               std::swap(output_, g.token_list_);
+            }
+
+            void assembly_pipeline::push(const std::size_t index, const token& t)
+            {
+               if (index == stage_list_.size())
+               {
+                  scan(t);
+                  return;
+               }
+
+               stage& s = stage_list_[index];
+
+               if (e_modifier == s.type)
+               {
+                  token m = t;
+                  static_cast<token_modifier*>(s.helper)->modify(m);
+                  push(index + 1, m);
+                  return;
+               }
+
+               s.window.push_back(t);
+
+               if (s.window.size() < s.stride)
+                  return;
+
+               const token_list_t& w = s.window;
+               token r;
+
+               if (e_inserter == s.type)
+               {
+                  token_inserter& inserter = *static_cast<token_inserter*>(s.helper);
+                  int insert_index = -1;
+
+                  switch (s.stride)
+                  {
+                     case 1 : insert_index = inserter.insert(w[0], r);
+                              break;
+
+                     case 2 : insert_index = inserter.insert(w[0], w[1], r);
+                              break;
+
+                     case 3 : insert_index = inserter.insert(w[0], w[1], w[2], r);
+                              break;
+
+                     case 4 : insert_index = inserter.insert(w[0], w[1], w[2], w[3], r);
+                              break;
+
+                     case 5 : insert_index = inserter.insert(w[0], w[1], w[2], w[3], w[4], r);
+                              break;
+                  }
+
+                  push(index + 1, w[0]);
+
+                  if ((insert_index >= 0) && (insert_index <= (static_cast<int>(s.stride) + 1)))
+                  {
+                     push(index + 1, r);
+                  }
+
+                  s.window.erase(s.window.begin());
+               }
+               else
+               {
+                  token_joiner& joiner = *static_cast<token_joiner*>(s.helper);
+                  bool joined = false;
+
+                  switch (s.stride)
+                  {
+                     case 2 : joined = joiner.join(w[0], w[1], r);
+                              break;
+
+                     case 3 : joined = joiner.join(w[0], w[1], w[2], r);
+                              break;
+                  }
+
+                  if (joined)
+                  {
+                     push(index + 1, r);
+                     s.window.clear();
+                  }
+                  else
+                  {
+                     push(index + 1, w[0]);
+                     s.window.erase(s.window.begin());
+                  }
+               }
+            }
+
+            void assembly_pipeline::flush(const std::size_t index)
+            {
+               if (index == stage_list_.size())
+                  return;
+
+               stage& s = stage_list_[index];
+
+               for (std::size_t i = 0; i < s.window.size(); ++i)
+               {
+                  push(index + 1, s.window[i]);
+               }
+
+               s.window.clear();
+
+               flush(index + 1);
+            }
+
+            void assembly_pipeline::scan(const token& t)
+            {
+               output_.push_back(t);
+
+               const std::size_t n = output_.size();
+
+               for (std::size_t i = 0; i < scanner_list_.size(); ++i)
+               {
+                  if (!scanner_active_[i])
+                     continue;
+
+                  token_scanner& scanner = *scanner_list_[i];
+
+                  if (n < scanner.stride())
+                     continue;
+
+                  bool state = true;
+
+                  switch (scanner.stride())
+                  {
+                     case 1 : state = scanner(output_[n - 1]);
+                              break;
+
+                     case 2 : state = scanner(output_[n - 2], output_[n - 1]);
+                              break;
+
+                     case 3 : state = scanner(output_[n - 3], output_[n - 2], output_[n - 1]);
+                              break;
+
+                     case 4 : state = scanner(output_[n - 4], output_[n - 3], output_[n - 2], output_[n - 1]);
+                              break;
+                  }
+
+                  if (!state)
+                  {
+                     scanner_active_[i] = false;
+                  }
+               }
+            }
+
             bool helper_assembly::register_scanner(lexer::token_scanner* scanner)
             {
                if (token_scanner_list.end() != std::find(token_scanner_list.begin(),
@@ -1052,6 +1271,108 @@ namespace Essa::Math{
                return true;
             }
 
+            bool helper_assembly::run_assembly(lexer::generator& g,
+                                               const bool inserters,
+                                               const bool joiners,
+                                               const bool modifiers,
+                                               const bool scanners)
+            {
+               error_token_inserter = reinterpret_cast<lexer::token_inserter*>(0);
+               error_token_joiner   = reinterpret_cast<lexer::token_joiner*  >(0);
+               error_token_modifier = reinterpret_cast<lexer::token_modifier*>(0);
+               error_token_scanner  = reinterpret_cast<lexer::token_scanner* >(0);
+
+               assembly_pipeline pipeline(assembly_list);
+
+               if (inserters)
+               {
+                  for (std::size_t i = 0; i < token_inserter_list.size(); ++i)
+                  {
+                     token_inserter_list[i]->reset();
+                     pipeline.add_inserter(token_inserter_list[i]);
+                  }
+               }
+
+               if (joiners)
+               {
+                  for (std::size_t i = 0; i < token_joiner_list.size(); ++i)
+                  {
+                     token_joiner_list[i]->reset();
+                     pipeline.add_joiner(token_joiner_list[i]);
+                  }
+               }
+
+               if (modifiers)
+               {
+                  for (std::size_t i = 0; i < token_modifier_list.size(); ++i)
+                  {
+                     token_modifier_list[i]->reset();
+                     pipeline.add_modifier(token_modifier_list[i]);
+                  }
+               }
+
+               if (scanners)
+               {
+                  for (std::size_t i = 0; i < token_scanner_list.size(); ++i)
+                  {
+                     token_scanner_list[i]->reset();
+                     pipeline.add_scanner(token_scanner_list[i]);
+                  }
+               }
+
+               pipeline.process(g);
+
+               if (inserters)
+               {
+                  for (std::size_t i = 0; i < token_inserter_list.size(); ++i)
+                  {
+                     if (!token_inserter_list[i]->result())
+                     {
+                        error_token_inserter = token_inserter_list[i];
+                        break;
+                     }
+                  }
+               }
+
+               if (joiners)
+               {
+                  for (std::size_t i = 0; i < token_joiner_list.size(); ++i)
+                  {
+                     if (!token_joiner_list[i]->result())
+                     {
+                        error_token_joiner = token_joiner_list[i];
+                        break;
+                     }
+                  }
+               }
+
+               if (modifiers)
+               {
+                  for (std::size_t i = 0; i < token_modifier_list.size(); ++i)
+                  {
+                     if (!token_modifier_list[i]->result())
+                     {
+                        error_token_modifier = token_modifier_list[i];
+                        break;
+                     }
+                  }
+               }
+
+               if (scanners)
+               {
+                  for (std::size_t i = 0; i < token_scanner_list.size(); ++i)
+                  {
+                     if (!token_scanner_list[i]->result())
+                     {
+                        error_token_scanner = token_scanner_list[i];
+                        return false;
+                     }
+                  }
+               }
+
+               return true;
+            }
+
             bool helper_assembly::run_scanners(lexer::generator& g)
             {
                error_token_scanner = reinterpret_cast<lexer::token_scanner*>(0);
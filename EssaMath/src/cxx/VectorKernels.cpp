@@ -0,0 +1,1146 @@
+#include "include/VectorKernels.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+   #define exprtk_enable_simd_kernels
+   #define exprtk_simd_inline inline __attribute__((always_inline))
+
+   // The vector helpers below are only ever inlined into kernels built for
+   // the matching instruction set, so their nominal ABI does not matter.
+   #pragma GCC diagnostic ignored "-Wpsabi"
+
+   // Kernels have to round every operation separately, as the scalar
+   // loops do, even for targets that have fused multiply-add.
+   #pragma GCC optimize ("fp-contract=off")
+#endif
+
+namespace Essa::Math{
+   namespace details
+   {
+      template <typename T>
+      struct vector_kernel_table
+      {
+         typedef vector_kernels<T> kernels_t;
+
+         // Slots of the element wise operations, the last one stays null.
+         enum { e_slot_add, e_slot_sub, e_slot_mul, e_slot_div, e_slot_none };
+
+         vector_kernel_table()
+         : neg    (0)
+         , abs    (0)
+         , sum    (0)
+         , product(0)
+         , isa    ("scalar")
+         {
+            for (std::size_t i = 0; i <= e_slot_none; ++i)
+            {
+               vecvec[i] = 0;
+               vecval[i] = 0;
+               valvec[i] = 0;
+            }
+         }
+
+         static std::size_t slot(const operator_type operation)
+         {
+            switch (operation)
+            {
+               case e_add : return e_slot_add;
+               case e_sub : return e_slot_sub;
+               case e_mul : return e_slot_mul;
+               case e_div : return e_slot_div;
+               default    : return e_slot_none;
+            }
+         }
+
+         static vector_kernel_table<T> select();
+
+         static const vector_kernel_table<T>& instance();
+
+         typename kernels_t::vecvec_t vecvec[e_slot_none + 1];
+         typename kernels_t::vecval_t vecval[e_slot_none + 1];
+         typename kernels_t::valvec_t valvec[e_slot_none + 1];
+         typename kernels_t::unary_t  neg;
+         typename kernels_t::unary_t  abs;
+         typename kernels_t::reduce_t sum;
+         typename kernels_t::reduce_t product;
+         const char*                  isa;
+      };
+
+      #ifdef exprtk_enable_simd_kernels
+      template <typename T>
+      struct simd_traits
+      {
+         typedef T scalar_t;
+         static const bool enabled = false;
+         static const bool complex = false;
+      };
+
+      template <>
+      struct simd_traits<float>
+      {
+         typedef float   scalar_t;
+         typedef int32_t integer_t;
+         static const bool enabled = true;
+         static const bool complex = false;
+      };
+
+      template <>
+      struct simd_traits<double>
+      {
+         typedef double  scalar_t;
+         typedef int64_t integer_t;
+         static const bool enabled = true;
+         static const bool complex = false;
+      };
+
+      // Complex values are processed as interleaved real and imaginary
+      // lanes by the operations that act on both parts separately, and
+      // split into a vector of real parts and one of imaginary parts by
+      // multiplication and division.
+      template <>
+      struct simd_traits<std::complex<double> >
+      {
+         typedef double  scalar_t;
+         typedef int64_t integer_t;
+         static const bool enabled = true;
+         static const bool complex = true;
+      };
+
+      template <typename S, std::size_t Bytes>
+      struct simd_vector
+      {
+         typedef typename simd_traits<S>::integer_t integer_t;
+
+         typedef S         type  __attribute__((vector_size(Bytes)));
+         typedef integer_t itype __attribute__((vector_size(Bytes)));
+      };
+
+      template <typename V>
+      struct simd_unsigned
+      {
+         typedef uint64_t type __attribute__((vector_size(sizeof(V))));
+      };
+
+      // Magnitude bits of the double lanes of v.
+      template <typename V>
+      exprtk_simd_inline typename simd_unsigned<V>::type simd_magnitude(const V& v)
+      {
+         typedef typename simd_unsigned<V>::type U;
+
+         return reinterpret_cast<U>(v) & 0x7FFFFFFFFFFFFFFFull;
+      }
+
+      // One in the lanes holding a NaN, zero in the others. Lane tests are
+      // kept to integer arithmetic, as vector comparisons do not map onto
+      // every instruction set as well.
+      template <typename V>
+      exprtk_simd_inline typename simd_unsigned<V>::type simd_nan(const V& v)
+      {
+         return (0x7FF0000000000000ull - simd_magnitude(v)) >> 63;
+      }
+
+      template <typename U>
+      exprtk_simd_inline bool simd_none(const U& u)
+      {
+         uint64_t lane[sizeof(U) / sizeof(uint64_t)];
+         std::memcpy(lane, &u, sizeof(U));
+
+         uint64_t any = 0;
+
+         for (std::size_t i = 0; i < (sizeof(U) / sizeof(uint64_t)); ++i)
+         {
+            any |= lane[i];
+         }
+
+         return (0 == any);
+      }
+
+      struct simd_add_op
+      {
+         template <typename V>
+         static exprtk_simd_inline V process(const V& a, const V& b) { return a + b; }
+      };
+
+      struct simd_sub_op
+      {
+         template <typename V>
+         static exprtk_simd_inline V process(const V& a, const V& b) { return a - b; }
+      };
+
+      struct simd_mul_op
+      {
+         template <typename V>
+         static exprtk_simd_inline V process(const V& a, const V& b) { return a * b; }
+      };
+
+      struct simd_div_op
+      {
+         template <typename V>
+         static exprtk_simd_inline V process(const V& a, const V& b) { return a / b; }
+      };
+
+      struct simd_neg_op
+      {
+         template <typename V>
+         static exprtk_simd_inline V process(const V& a) { return -a; }
+      };
+
+      struct simd_abs_op
+      {
+         static exprtk_simd_inline float  process(const float  a) { return std::fabs(a); }
+         static exprtk_simd_inline double process(const double a) { return std::fabs(a); }
+
+         // Clears the sign bit of every lane, as fabs does.
+         template <typename V>
+         static exprtk_simd_inline V process(const V& a)
+         {
+            typedef typename std::remove_cv<typename std::remove_reference<decltype(a[0])>::type>::type scalar_t;
+            typedef typename simd_vector<scalar_t,sizeof(V)>::integer_t integer_t;
+            typedef typename simd_vector<scalar_t,sizeof(V)>::itype     itype;
+
+            const integer_t magnitude = std::numeric_limits<integer_t>::max();
+
+            return reinterpret_cast<V>(reinterpret_cast<itype>(a) & magnitude);
+         }
+      };
+
+      // Positions of the real and imaginary parts of Bytes / 8 complex
+      // values held in two vectors, and of the two vectors holding the
+      // values again.
+      template <std::size_t Bytes>
+      struct simd_complex_shuffle;
+
+      template <>
+      struct simd_complex_shuffle<16>
+      {
+         typedef simd_vector<double,16>::itype I;
+
+         static exprtk_simd_inline I real() { const I m = { 0, 2 }; return m; }
+         static exprtk_simd_inline I imag() { const I m = { 1, 3 }; return m; }
+         static exprtk_simd_inline I low () { const I m = { 0, 2 }; return m; }
+         static exprtk_simd_inline I high() { const I m = { 1, 3 }; return m; }
+      };
+
+      template <>
+      struct simd_complex_shuffle<32>
+      {
+         typedef simd_vector<double,32>::itype I;
+
+         static exprtk_simd_inline I real() { const I m = { 0, 2, 4, 6 }; return m; }
+         static exprtk_simd_inline I imag() { const I m = { 1, 3, 5, 7 }; return m; }
+         static exprtk_simd_inline I low () { const I m = { 0, 4, 1, 5 }; return m; }
+         static exprtk_simd_inline I high() { const I m = { 2, 6, 3, 7 }; return m; }
+      };
+
+      template <>
+      struct simd_complex_shuffle<64>
+      {
+         typedef simd_vector<double,64>::itype I;
+
+         static exprtk_simd_inline I real() { const I m = { 0, 2, 4,  6, 8, 10, 12, 14 }; return m; }
+         static exprtk_simd_inline I imag() { const I m = { 1, 3, 5,  7, 9, 11, 13, 15 }; return m; }
+         static exprtk_simd_inline I low () { const I m = { 0, 8, 1,  9, 2, 10,  3, 11 }; return m; }
+         static exprtk_simd_inline I high() { const I m = { 4, 12, 5, 13, 6, 14,  7, 15 }; return m; }
+      };
+
+      // (a + ib) * (c + id) as the compiler expands it, x = ac - bd and
+      // y = ad + bc, falling back on the library when both parts are NaN.
+      struct simd_complex_mul_op
+      {
+         template <typename T>
+         static exprtk_simd_inline T process(const T& v0, const T& v1) { return v0 * v1; }
+
+         template <typename V>
+         static exprtk_simd_inline bool process(const V& a, const V& b, const V& c, const V& d, V& x, V& y)
+         {
+            x = (a * c) - (b * d);
+            y = (a * d) + (b * c);
+
+            return simd_none(simd_nan(x) & simd_nan(y));
+         }
+      };
+
+      // Smith's algorithm as the library division (__divdc3) runs it. Its
+      // scaling steps change no result while all parts are zero or within
+      // [2^-256, 2^256) in magnitude, other values are left to it.
+      struct simd_complex_div_op
+      {
+         template <typename T>
+         static exprtk_simd_inline T process(const T& v0, const T& v1) { return v0 / v1; }
+
+         template <typename V>
+         static exprtk_simd_inline bool process(const V& a, const V& b, const V& c, const V& d, V& x, V& y)
+         {
+            typedef typename simd_unsigned<V>::type                U;
+            typedef typename simd_vector<double,sizeof(V)>::itype I;
+
+            const U zero_divisor = (nonzero(c) | nonzero(d)) ^ 1;
+
+            if (!simd_none(out_of_range(a) | out_of_range(b) | out_of_range(c) | out_of_range(d) | zero_divisor))
+               return false;
+
+            const V abs_c = simd_abs_op::process(c);
+            const V abs_d = simd_abs_op::process(d);
+
+            const I small_c = (abs_c < abs_d);
+
+            const V p = small_c ? c : d;
+            const V q = small_c ? d : c;
+            const V u = small_c ? a : b;
+            const V w = small_c ? b : a;
+
+            const V ratio = p / q;
+            const V denom = (p * ratio) + q;
+
+            x = ((u * ratio) + w) / denom;
+            y = (small_c ? ((b * ratio) - a) : (b - (a * ratio))) / denom;
+
+            return true;
+         }
+
+         template <typename V>
+         static exprtk_simd_inline typename simd_unsigned<V>::type nonzero(const V& v)
+         {
+            return (simd_magnitude(v) + 0x7FFFFFFFFFFFFFFFull) >> 63;
+         }
+
+         // Biased exponents 767 to 1278 cover [2^-256, 2^256).
+         template <typename V>
+         static exprtk_simd_inline typename simd_unsigned<V>::type out_of_range(const V& v)
+         {
+            return (((simd_magnitude(v) >> 52) - 767) >> 9) & (0 - nonzero(v));
+         }
+      };
+
+      template <typename T, std::size_t Bytes>
+      struct simd_kernel
+      {
+         typedef typename simd_traits<T>::scalar_t         S;
+         typedef typename simd_vector<S,Bytes>::type       V;
+
+         // Lanes in a vector register and lanes making up a value of T.
+         static const std::size_t lanes       = Bytes / sizeof(S);
+         static const std::size_t per_element = sizeof(T) / sizeof(S);
+
+         // Same as loop_unroll::global_loop_batch_size, the number of
+         // partial results vec_add_op and vec_mul_op keep.
+         static const std::size_t batch_size   = 16;
+         static const std::size_t accumulators = (batch_size * per_element) / lanes;
+
+         static exprtk_simd_inline V load(const S* p)
+         {
+            V v;
+            std::memcpy(&v, p, sizeof(V));
+            return v;
+         }
+
+         static exprtk_simd_inline void store(S* p, const V& v)
+         {
+            std::memcpy(p, &v, sizeof(V));
+         }
+
+         template <typename Op>
+         static exprtk_simd_inline void vecvec(const T* v0, const T* v1, T* result, const std::size_t size)
+         {
+            const S* a = reinterpret_cast<const S*>(v0);
+            const S* b = reinterpret_cast<const S*>(v1);
+                  S* r = reinterpret_cast<S*>(result);
+
+            const std::size_t n = size * per_element;
+            std::size_t i = 0;
+
+            for ( ; (i + lanes) <= n; i += lanes)
+            {
+               store(r + i, Op::process(load(a + i), load(b + i)));
+            }
+
+            for ( ; i < n; ++i)
+            {
+               r[i] = Op::process(a[i], b[i]);
+            }
+         }
+
+         template <typename Op>
+         static exprtk_simd_inline void vecval(const T* v0, const T& v1, T* result, const std::size_t size)
+         {
+            const S* a = reinterpret_cast<const S*>(v0);
+            const S* b = reinterpret_cast<const S*>(&v1);
+                  S* r = reinterpret_cast<S*>(result);
+
+            S pattern[lanes];
+
+            for (std::size_t k = 0; k < lanes; ++k)
+            {
+               pattern[k] = b[k % per_element];
+            }
+
+            const V bv = load(pattern);
+            const std::size_t n = size * per_element;
+            std::size_t i = 0;
+
+            for ( ; (i + lanes) <= n; i += lanes)
+            {
+               store(r + i, Op::process(load(a + i), bv));
+            }
+
+            for ( ; i < n; ++i)
+            {
+               r[i] = Op::process(a[i], b[i % per_element]);
+            }
+         }
+
+         template <typename Op>
+         static exprtk_simd_inline void valvec(const T& v0, const T* v1, T* result, const std::size_t size)
+         {
+            const S* a = reinterpret_cast<const S*>(&v0);
+            const S* b = reinterpret_cast<const S*>(v1);
+                  S* r = reinterpret_cast<S*>(result);
+
+            S pattern[lanes];
+
+            for (std::size_t k = 0; k < lanes; ++k)
+            {
+               pattern[k] = a[k % per_element];
+            }
+
+            const V av = load(pattern);
+            const std::size_t n = size * per_element;
+            std::size_t i = 0;
+
+            for ( ; (i + lanes) <= n; i += lanes)
+            {
+               store(r + i, Op::process(av, load(b + i)));
+            }
+
+            for ( ; i < n; ++i)
+            {
+               r[i] = Op::process(a[i % per_element], b[i]);
+            }
+         }
+
+         template <typename Op>
+         static exprtk_simd_inline void unary(const T* v0, T* result, const std::size_t size)
+         {
+            const S* a = reinterpret_cast<const S*>(v0);
+                  S* r = reinterpret_cast<S*>(result);
+
+            const std::size_t n = size * per_element;
+            std::size_t i = 0;
+
+            for ( ; (i + lanes) <= n; i += lanes)
+            {
+               store(r + i, Op::process(load(a + i)));
+            }
+
+            for ( ; i < n; ++i)
+            {
+               r[i] = Op::process(a[i]);
+            }
+         }
+
+         // Accumulator k holds the partials k * lanes .. (k + 1) * lanes - 1,
+         // which keeps the order of every partial's operations unchanged.
+         template <typename Op>
+         static exprtk_simd_inline void reduce(const T* v0, const std::size_t size, T* partial)
+         {
+            const S* a = reinterpret_cast<const S*>(v0);
+                  S* p = reinterpret_cast<S*>(partial);
+
+            V acc[accumulators];
+
+            for (std::size_t k = 0; k < accumulators; ++k)
+            {
+               acc[k] = load(p + k * lanes);
+            }
+
+            const std::size_t n = size * per_element;
+
+            for (std::size_t i = 0; i < n; i += batch_size * per_element)
+            {
+               for (std::size_t k = 0; k < accumulators; ++k)
+               {
+                  acc[k] = Op::process(acc[k], load(a + i + k * lanes));
+               }
+            }
+
+            for (std::size_t k = 0; k < accumulators; ++k)
+            {
+               store(p + k * lanes, acc[k]);
+            }
+         }
+      };
+
+      // Processes lanes complex values at a time, held as a vector of real
+      // parts and a vector of imaginary parts. Blocks the operation does
+      // not take are computed with std::complex, value by value.
+      template <typename T, std::size_t Bytes>
+      struct simd_complex_kernel
+      {
+         typedef simd_kernel<T,Bytes>        kernel_t;
+         typedef typename kernel_t::S        S;
+         typedef typename kernel_t::V        V;
+         typedef simd_complex_shuffle<Bytes> shuffle_t;
+
+         static const std::size_t lanes = kernel_t::lanes;
+
+         static exprtk_simd_inline void split(const S* p, V& re, V& im)
+         {
+            const V v0 = kernel_t::load(p);
+            const V v1 = kernel_t::load(p + lanes);
+
+            re = __builtin_shuffle(v0, v1, shuffle_t::real());
+            im = __builtin_shuffle(v0, v1, shuffle_t::imag());
+         }
+
+         static exprtk_simd_inline void join(S* p, const V& re, const V& im)
+         {
+            kernel_t::store(p        , __builtin_shuffle(re, im, shuffle_t::low ()));
+            kernel_t::store(p + lanes, __builtin_shuffle(re, im, shuffle_t::high()));
+         }
+
+         static exprtk_simd_inline V broadcast(const S& s)
+         {
+            return V() + s;
+         }
+
+         template <typename Op>
+         static exprtk_simd_inline void vecvec(const T* v0, const T* v1, T* result, const std::size_t size)
+         {
+            const S* a = reinterpret_cast<const S*>(v0);
+            const S* b = reinterpret_cast<const S*>(v1);
+                  S* r = reinterpret_cast<S*>(result);
+
+            std::size_t i = 0;
+
+            for ( ; (i + lanes) <= size; i += lanes)
+            {
+               V ar, ai, br, bi, rr, ri;
+
+               split(a + 2 * i, ar, ai);
+               split(b + 2 * i, br, bi);
+
+               if (Op::process(ar, ai, br, bi, rr, ri))
+                  join(r + 2 * i, rr, ri);
+               else
+               {
+                  for (std::size_t k = i; k < (i + lanes); ++k)
+                  {
+                     result[k] = Op::process(v0[k], v1[k]);
+                  }
+               }
+            }
+
+            for ( ; i < size; ++i)
+            {
+               result[i] = Op::process(v0[i], v1[i]);
+            }
+         }
+
+         template <typename Op>
+         static exprtk_simd_inline void vecval(const T* v0, const T& v1, T* result, const std::size_t size)
+         {
+            const S* a = reinterpret_cast<const S*>(v0);
+                  S* r = reinterpret_cast<S*>(result);
+
+            const V br = broadcast(v1.real());
+            const V bi = broadcast(v1.imag());
+
+            std::size_t i = 0;
+
+            for ( ; (i + lanes) <= size; i += lanes)
+            {
+               V ar, ai, rr, ri;
+
+               split(a + 2 * i, ar, ai);
+
+               if (Op::process(ar, ai, br, bi, rr, ri))
+                  join(r + 2 * i, rr, ri);
+               else
+               {
+                  for (std::size_t k = i; k < (i + lanes); ++k)
+                  {
+                     result[k] = Op::process(v0[k], v1);
+                  }
+               }
+            }
+
+            for ( ; i < size; ++i)
+            {
+               result[i] = Op::process(v0[i], v1);
+            }
+         }
+
+         template <typename Op>
+         static exprtk_simd_inline void valvec(const T& v0, const T* v1, T* result, const std::size_t size)
+         {
+            const S* b = reinterpret_cast<const S*>(v1);
+                  S* r = reinterpret_cast<S*>(result);
+
+            const V ar = broadcast(v0.real());
+            const V ai = broadcast(v0.imag());
+
+            std::size_t i = 0;
+
+            for ( ; (i + lanes) <= size; i += lanes)
+            {
+               V br, bi, rr, ri;
+
+               split(b + 2 * i, br, bi);
+
+               if (Op::process(ar, ai, br, bi, rr, ri))
+                  join(r + 2 * i, rr, ri);
+               else
+               {
+                  for (std::size_t k = i; k < (i + lanes); ++k)
+                  {
+                     result[k] = Op::process(v0, v1[k]);
+                  }
+               }
+            }
+
+            for ( ; i < size; ++i)
+            {
+               result[i] = Op::process(v0, v1[i]);
+            }
+         }
+      };
+
+      #define exprtk_define_simd_isa(Isa, Target, Bytes)                                         \
+      template <typename T>                                                                      \
+      struct simd_##Isa                                                                          \
+      {                                                                                          \
+         typedef simd_kernel<T,Bytes> kernel_t;                                                  \
+                                                                                                 \
+         template <typename Op>                                                                  \
+         __attribute__((target(Target)))                                                         \
+         static void vecvec(const T* v0, const T* v1, T* result, const std::size_t size)         \
+         {                                                                                       \
+            kernel_t::template vecvec<Op>(v0, v1, result, size);                                 \
+         }                                                                                       \
+                                                                                                 \
+         template <typename Op>                                                                  \
+         __attribute__((target(Target)))                                                         \
+         static void vecval(const T* v0, const T& v1, T* result, const std::size_t size)         \
+         {                                                                                       \
+            kernel_t::template vecval<Op>(v0, v1, result, size);                                 \
+         }                                                                                       \
+                                                                                                 \
+         template <typename Op>                                                                  \
+         __attribute__((target(Target)))                                                         \
+         static void valvec(const T& v0, const T* v1, T* result, const std::size_t size)         \
+         {                                                                                       \
+            kernel_t::template valvec<Op>(v0, v1, result, size);                                 \
+         }                                                                                       \
+                                                                                                 \
+         template <typename Op>                                                                  \
+         __attribute__((target(Target)))                                                         \
+         static void unary(const T* v0, T* result, const std::size_t size)                       \
+         {                                                                                       \
+            kernel_t::template unary<Op>(v0, result, size);                                      \
+         }                                                                                       \
+                                                                                                 \
+         template <typename Op>                                                                  \
+         __attribute__((target(Target)))                                                         \
+         static void reduce(const T* v0, const std::size_t size, T* partial)                     \
+         {                                                                                       \
+            kernel_t::template reduce<Op>(v0, size, partial);                                    \
+         }                                                                                       \
+                                                                                                 \
+         template <typename Op>                                                                  \
+         __attribute__((target(Target)))                                                         \
+         static void complex_vecvec(const T* v0, const T* v1, T* result, const std::size_t size) \
+         {                                                                                       \
+            simd_complex_kernel<T,Bytes>::template vecvec<Op>(v0, v1, result, size);             \
+         }                                                                                       \
+                                                                                                 \
+         template <typename Op>                                                                  \
+         __attribute__((target(Target)))                                                         \
+         static void complex_vecval(const T* v0, const T& v1, T* result, const std::size_t size) \
+         {                                                                                       \
+            simd_complex_kernel<T,Bytes>::template vecval<Op>(v0, v1, result, size);             \
+         }                                                                                       \
+                                                                                                 \
+         template <typename Op>                                                                  \
+         __attribute__((target(Target)))                                                         \
+         static void complex_valvec(const T& v0, const T* v1, T* result, const std::size_t size) \
+         {                                                                                       \
+            simd_complex_kernel<T,Bytes>::template valvec<Op>(v0, v1, result, size);             \
+         }                                                                                       \
+      };                                                                                         \
+
+      exprtk_define_simd_isa(sse2  , "sse2"   , 16)
+      exprtk_define_simd_isa(avx2  , "avx2"   , 32)
+      exprtk_define_simd_isa(avx512, "avx512f", 64)
+
+      #undef exprtk_define_simd_isa
+
+      template <typename T, template <typename> class Isa, bool Complex = simd_traits<T>::complex>
+      struct simd_table_builder
+      {
+         typedef vector_kernel_table<T> table_t;
+         typedef Isa<T>                 isa_t;
+
+         static void fill(table_t& table, const char* isa)
+         {
+            table.vecvec[table_t::e_slot_add] = &isa_t::template vecvec<simd_add_op>;
+            table.vecvec[table_t::e_slot_sub] = &isa_t::template vecvec<simd_sub_op>;
+            table.vecvec[table_t::e_slot_mul] = &isa_t::template vecvec<simd_mul_op>;
+            table.vecvec[table_t::e_slot_div] = &isa_t::template vecvec<simd_div_op>;
+            table.vecval[table_t::e_slot_add] = &isa_t::template vecval<simd_add_op>;
+            table.vecval[table_t::e_slot_sub] = &isa_t::template vecval<simd_sub_op>;
+            table.vecval[table_t::e_slot_mul] = &isa_t::template vecval<simd_mul_op>;
+            table.vecval[table_t::e_slot_div] = &isa_t::template vecval<simd_div_op>;
+            table.valvec[table_t::e_slot_add] = &isa_t::template valvec<simd_add_op>;
+            table.valvec[table_t::e_slot_sub] = &isa_t::template valvec<simd_sub_op>;
+            table.valvec[table_t::e_slot_mul] = &isa_t::template valvec<simd_mul_op>;
+            table.valvec[table_t::e_slot_div] = &isa_t::template valvec<simd_div_op>;
+            table.neg                         = &isa_t::template unary <simd_neg_op>;
+            table.abs                         = &isa_t::template unary <simd_abs_op>;
+            table.sum                         = &isa_t::template reduce<simd_add_op>;
+            table.product                     = &isa_t::template reduce<simd_mul_op>;
+            table.isa                         = isa;
+         }
+      };
+
+      template <typename T, template <typename> class Isa>
+      struct simd_table_builder<T,Isa,true>
+      {
+         typedef vector_kernel_table<T> table_t;
+         typedef Isa<T>                 isa_t;
+
+         static void fill(table_t& table, const char* isa)
+         {
+            table.vecvec[table_t::e_slot_add] = &isa_t::template vecvec<simd_add_op>;
+            table.vecvec[table_t::e_slot_sub] = &isa_t::template vecvec<simd_sub_op>;
+            table.vecvec[table_t::e_slot_mul] = &isa_t::template complex_vecvec<simd_complex_mul_op>;
+            table.vecvec[table_t::e_slot_div] = &isa_t::template complex_vecvec<simd_complex_div_op>;
+            table.vecval[table_t::e_slot_add] = &isa_t::template vecval<simd_add_op>;
+            table.vecval[table_t::e_slot_sub] = &isa_t::template vecval<simd_sub_op>;
+            table.vecval[table_t::e_slot_mul] = &isa_t::template complex_vecval<simd_complex_mul_op>;
+            table.vecval[table_t::e_slot_div] = &isa_t::template complex_vecval<simd_complex_div_op>;
+            table.valvec[table_t::e_slot_add] = &isa_t::template valvec<simd_add_op>;
+            table.valvec[table_t::e_slot_sub] = &isa_t::template valvec<simd_sub_op>;
+            table.valvec[table_t::e_slot_mul] = &isa_t::template complex_valvec<simd_complex_mul_op>;
+            table.valvec[table_t::e_slot_div] = &isa_t::template complex_valvec<simd_complex_div_op>;
+            table.neg                         = &isa_t::template unary <simd_neg_op>;
+            table.abs                         = &isa_t::template unary <simd_abs_op>;
+            table.sum                         = &isa_t::template reduce<simd_add_op>;
+            table.isa                         = isa;
+         }
+      };
+
+      template <typename T, bool Enabled = simd_traits<T>::enabled>
+      struct simd_table_selector
+      {
+         static void select(vector_kernel_table<T>&)
+         {}
+      };
+
+      template <typename T>
+      struct simd_table_selector<T,true>
+      {
+         static void select(vector_kernel_table<T>& table)
+         {
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx512f"))
+               simd_table_builder<T,simd_avx512>::fill(table, "avx512f");
+            else if (__builtin_cpu_supports("avx2"))
+               simd_table_builder<T,simd_avx2  >::fill(table, "avx2"   );
+            else if (__builtin_cpu_supports("sse2"))
+               simd_table_builder<T,simd_sse2  >::fill(table, "sse2"   );
+         }
+      };
+      #endif
+
+      template<typename T> vector_kernel_table<T> vector_kernel_table<T>::select()
+      {
+         vector_kernel_table<T> table;
+
+         #ifdef exprtk_enable_simd_kernels
+         simd_table_selector<T>::select(table);
+         #endif
+
+         return table;
+      }
+
+      template<typename T> const vector_kernel_table<T>& vector_kernel_table<T>::instance()
+      {
+         static const vector_kernel_table<T> table = select();
+
+         return table;
+      }
+
+      template<typename T> typename vector_kernels<T>::vecvec_t vector_kernels<T>::vecvec(const operator_type operation)
+      {
+         return vector_kernel_table<T>::instance().vecvec[vector_kernel_table<T>::slot(operation)];
+      }
+
+      template<typename T> typename vector_kernels<T>::vecval_t vector_kernels<T>::vecval(const operator_type operation)
+      {
+         return vector_kernel_table<T>::instance().vecval[vector_kernel_table<T>::slot(operation)];
+      }
+
+      template<typename T> typename vector_kernels<T>::valvec_t vector_kernels<T>::valvec(const operator_type operation)
+      {
+         return vector_kernel_table<T>::instance().valvec[vector_kernel_table<T>::slot(operation)];
+      }
+
+      template<typename T> typename vector_kernels<T>::unary_t vector_kernels<T>::unary(const operator_type operation)
+      {
+         switch (operation)
+         {
+            case e_neg : return vector_kernel_table<T>::instance().neg;
+            case e_abs : return vector_kernel_table<T>::instance().abs;
+            default    : return 0;
+         }
+      }
+
+      template<typename T> typename vector_kernels<T>::reduce_t vector_kernels<T>::sum()
+      {
+         return vector_kernel_table<T>::instance().sum;
+      }
+
+      template<typename T> typename vector_kernels<T>::reduce_t vector_kernels<T>::product()
+      {
+         return vector_kernel_table<T>::instance().product;
+      }
+
+      template<typename T> const char* vector_kernels<T>::isa()
+      {
+         return vector_kernel_table<T>::instance().isa;
+      }
+
+      template <typename T>
+      struct vector_task
+      {
+         typedef vector_kernels<T> kernels_t;
+
+         static void vecvec(void* context, const std::size_t, const std::size_t begin, const std::size_t end)
+         {
+            const vector_task<T>& t = *static_cast<const vector_task<T>*>(context);
+            t.vecvec_kernel(t.v0 + begin, t.v1 + begin, t.result + begin, end - begin);
+         }
+
+         static void vecval(void* context, const std::size_t, const std::size_t begin, const std::size_t end)
+         {
+            const vector_task<T>& t = *static_cast<const vector_task<T>*>(context);
+            t.vecval_kernel(t.v0 + begin, *t.value, t.result + begin, end - begin);
+         }
+
+         static void valvec(void* context, const std::size_t, const std::size_t begin, const std::size_t end)
+         {
+            const vector_task<T>& t = *static_cast<const vector_task<T>*>(context);
+            t.valvec_kernel(*t.value, t.v1 + begin, t.result + begin, end - begin);
+         }
+
+         static void unary(void* context, const std::size_t, const std::size_t begin, const std::size_t end)
+         {
+            const vector_task<T>& t = *static_cast<const vector_task<T>*>(context);
+            t.unary_kernel(t.v0 + begin, t.result + begin, end - begin);
+         }
+
+         typename kernels_t::vecvec_t vecvec_kernel;
+         typename kernels_t::vecval_t vecval_kernel;
+         typename kernels_t::valvec_t valvec_kernel;
+         typename kernels_t::unary_t  unary_kernel;
+
+         const T* v0;
+         const T* v1;
+         const T* value;
+         T*       result;
+      };
+
+      template<typename T> void vector_kernels<T>::run(vecvec_t kernel, const T* v0, const T* v1, T* result, const std::size_t size)
+      {
+         if (size < vector_thread_pool::threshold())
+         {
+            kernel(v0, v1, result, size);
+            return;
+         }
+
+         vector_task<T> t = vector_task<T>();
+         t.vecvec_kernel = kernel;
+         t.v0            = v0;
+         t.v1            = v1;
+         t.result        = result;
+
+         vector_thread_pool::run(&vector_task<T>::vecvec, &t, size);
+      }
+
+      template<typename T> void vector_kernels<T>::run(vecval_t kernel, const T* v0, const T& v1, T* result, const std::size_t size)
+      {
+         if (size < vector_thread_pool::threshold())
+         {
+            kernel(v0, v1, result, size);
+            return;
+         }
+
+         vector_task<T> t = vector_task<T>();
+         t.vecval_kernel = kernel;
+         t.v0            = v0;
+         t.value         = &v1;
+         t.result        = result;
+
+         vector_thread_pool::run(&vector_task<T>::vecval, &t, size);
+      }
+
+      template<typename T> void vector_kernels<T>::run(valvec_t kernel, const T& v0, const T* v1, T* result, const std::size_t size)
+      {
+         if (size < vector_thread_pool::threshold())
+         {
+            kernel(v0, v1, result, size);
+            return;
+         }
+
+         vector_task<T> t = vector_task<T>();
+         t.valvec_kernel = kernel;
+         t.value         = &v0;
+         t.v1            = v1;
+         t.result        = result;
+
+         vector_thread_pool::run(&vector_task<T>::valvec, &t, size);
+      }
+
+      template<typename T> void vector_kernels<T>::run(unary_t kernel, const T* v0, T* result, const std::size_t size)
+      {
+         if (size < vector_thread_pool::threshold())
+         {
+            kernel(v0, result, size);
+            return;
+         }
+
+         vector_task<T> t = vector_task<T>();
+         t.unary_kernel = kernel;
+         t.v0           = v0;
+         t.result       = result;
+
+         vector_thread_pool::run(&vector_task<T>::unary, &t, size);
+      }
+
+      struct vector_thread_pool::state
+      {
+         state()
+         : threshold   (262144)
+         , thread_count(std::max<std::size_t>(1, std::thread::hardware_concurrency()))
+         , generation  (0)
+         , active      (0)
+         , stop        (false)
+         , task        (0)
+         , context     (0)
+         , size        (0)
+         , chunks      (0)
+         , finished    (0)
+         , next        (0)
+         {}
+
+        ~state()
+         {
+            stop_workers();
+         }
+
+         void stop_workers()
+         {
+            {
+               std::lock_guard<std::mutex> lock(mutex);
+               stop = true;
+            }
+
+            start.notify_all();
+
+            for (std::size_t i = 0; i < worker_list.size(); ++i)
+            {
+               worker_list[i].join();
+            }
+
+            worker_list.clear();
+            stop = false;
+         }
+
+         // Held by the thread running work on the pool.
+         std::mutex               run_mutex;
+
+         std::mutex               mutex;
+         std::condition_variable  start;
+         std::condition_variable  finish;
+         std::vector<std::thread> worker_list;
+         std::atomic<std::size_t> threshold;
+         std::size_t              thread_count;
+         std::size_t              generation;
+         std::size_t              active;
+         bool                     stop;
+
+         task_t                   task;
+         void*                    context;
+         std::size_t              size;
+         std::size_t              chunks;
+         std::size_t              finished;
+         std::atomic<std::size_t> next;
+      };
+
+      void vector_thread_pool::run(task_t task, void* context, const std::size_t size)
+      {
+         const std::size_t chunks = chunk_count(size);
+
+         if (1 == chunks)
+         {
+            task(context, 0, 0, size);
+            return;
+         }
+
+         state& s = instance();
+
+         std::unique_lock<std::mutex> run_lock(s.run_mutex, std::try_to_lock);
+
+         if (!run_lock.owns_lock() || (s.thread_count < 2))
+         {
+            for (std::size_t i = 0; i < chunks; ++i)
+            {
+               task(context, i, i * chunk_size, std::min(size, (i + 1) * chunk_size));
+            }
+
+            return;
+         }
+
+         while (s.worker_list.size() < (s.thread_count - 1))
+         {
+            s.worker_list.push_back(std::thread(&vector_thread_pool::worker, &s, s.generation));
+         }
+
+         std::unique_lock<std::mutex> lock(s.mutex);
+
+         // Workers still finishing the previous run may read the task.
+         while (0 != s.active)
+         {
+            s.finish.wait(lock);
+         }
+
+         s.task     = task;
+         s.context  = context;
+         s.size     = size;
+         s.chunks   = chunks;
+         s.finished = 0;
+         s.next     = 0;
+         ++s.generation;
+
+         lock.unlock();
+         s.start.notify_all();
+
+         work(s);
+
+         lock.lock();
+
+         while ((s.finished != s.chunks) || (0 != s.active))
+         {
+            s.finish.wait(lock);
+         }
+      }
+
+      std::size_t vector_thread_pool::chunk_count(const std::size_t size)
+      {
+         if (size < threshold())
+            return 1;
+
+         return (size + chunk_size - 1) / chunk_size;
+      }
+
+      std::size_t vector_thread_pool::threshold()
+      {
+         return instance().threshold;
+      }
+
+      void vector_thread_pool::set_threshold(const std::size_t size)
+      {
+         instance().threshold = size;
+      }
+
+      std::size_t vector_thread_pool::thread_count()
+      {
+         return instance().thread_count;
+      }
+
+      void vector_thread_pool::set_thread_count(const std::size_t count)
+      {
+         state& s = instance();
+
+         std::lock_guard<std::mutex> run_lock(s.run_mutex);
+
+         s.stop_workers();
+         s.thread_count = (0 == count) ? std::max<std::size_t>(1, std::thread::hardware_concurrency()) : count;
+      }
+
+      vector_thread_pool::state& vector_thread_pool::instance()
+      {
+         static state s;
+
+         return s;
+      }
+
+      void vector_thread_pool::work(state& s)
+      {
+         std::size_t done = 0;
+
+         for (std::size_t i = s.next++; i < s.chunks; i = s.next++)
+         {
+            s.task(s.context, i, i * chunk_size, std::min(s.size, (i + 1) * chunk_size));
+            ++done;
+         }
+
+         if (0 != done)
+         {
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.finished += done;
+         }
+      }
+
+      void vector_thread_pool::worker(state* s, std::size_t generation)
+      {
+         for ( ; ; )
+         {
+            {
+               std::unique_lock<std::mutex> lock(s->mutex);
+
+               while (!s->stop && (generation == s->generation))
+               {
+                  s->start.wait(lock);
+               }
+
+               if (s->stop)
+                  return;
+
+               generation = s->generation;
+               ++s->active;
+            }
+
+            work(*s);
+
+            {
+               std::lock_guard<std::mutex> lock(s->mutex);
+               --s->active;
+            }
+
+            s->finish.notify_all();
+         }
+      }
+
+      template struct vector_kernels<int16_t>;
+      template struct vector_kernels<int32_t>;
+      template struct vector_kernels<int64_t>;
+      template struct vector_kernels<float>;
+      template struct vector_kernels<double>;
+      template struct vector_kernels<long double>;
+      template struct vector_kernels<std::complex<float>>;
+      template struct vector_kernels<std::complex<double>>;
+      template struct vector_kernels<std::complex<long double>>;
+   }
+}
@@ -0,0 +1,651 @@
+#include "include/VectorMath.hpp"
+#include "include/Operators.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+   #define exprtk_enable_vector_math
+   #define exprtk_simd_inline inline __attribute__((always_inline))
+
+   #pragma GCC diagnostic ignored "-Wpsabi"
+
+   // The error bounds hold for separately rounded operations only.
+   #pragma GCC optimize ("fp-contract=off")
+#endif
+
+namespace Essa::Math{
+   namespace details
+   {
+      template <typename T>
+      struct vector_math_table
+      {
+         typedef typename vector_math<T>::unary_t unary_t;
+
+         vector_math_table()
+         : exp  (0)
+         , expm1(0)
+         , log  (0)
+         , sin  (0)
+         , cos  (0)
+         , tanh (0)
+         , isa  ("scalar")
+         {}
+
+         static vector_math_table<T> select();
+
+         static const vector_math_table<T>& instance();
+
+         unary_t     exp;
+         unary_t     expm1;
+         unary_t     log;
+         unary_t     sin;
+         unary_t     cos;
+         unary_t     tanh;
+         const char* isa;
+      };
+
+      #ifdef exprtk_enable_vector_math
+      template <typename S>
+      struct vector_math_traits
+      {
+         static const bool enabled = false;
+      };
+
+      template <>
+      struct vector_math_traits<float>
+      {
+         typedef uint32_t unsigned_t;
+         typedef int32_t  signed_t;
+
+         static const bool        enabled       = true;
+         static const std::size_t mantissa_bits = 23;
+         static const unsigned_t  bias          = 127;
+         static const unsigned_t  sqrt_half     = 0x3F3504F3;
+
+         // Adding 1.5 * 2^23 rounds values below 2^22 in magnitude to an
+         // integer held in the low mantissa bits.
+         static const float shifter;
+         static const float log2e;
+         static const float ln2_hi;
+         static const float ln2_lo;
+         static const float exp_min;
+         static const float exp_max;
+         static const float min_normal;
+         static const float subnormal_scale;
+         static const float subnormal_exponent;
+
+         static const float exp_polynomial[6];
+         static const float log_polynomial[6];
+
+         // Of the double precision evaluation sin and cos are widened to.
+         static const double sin_polynomial[4];
+         static const double cos_polynomial[4];
+      };
+
+      const float vector_math_traits<float>::shifter            = 12582912.0f;
+      const float vector_math_traits<float>::log2e              = 1.44269504e+00f;
+      const float vector_math_traits<float>::ln2_hi             = 6.93359375e-01f;
+      const float vector_math_traits<float>::ln2_lo             = -2.12194440e-04f;
+      const float vector_math_traits<float>::exp_min            = -104.0f;
+      const float vector_math_traits<float>::exp_max            = 89.0f;
+      const float vector_math_traits<float>::min_normal         = 1.17549435e-38f;
+      const float vector_math_traits<float>::subnormal_scale    = 33554432.0f;
+      const float vector_math_traits<float>::subnormal_exponent = -25.0f;
+
+      // 1 / k! for k = 2 .. 7.
+      const float vector_math_traits<float>::exp_polynomial[6] =
+      {
+         5.000000000e-01f, 1.666666716e-01f, 4.166666791e-02f,
+         8.333333768e-03f, 1.388888923e-03f, 1.984127011e-04f
+      };
+
+      // 2 / (2k + 1) for k = 1 .. 6.
+      const float vector_math_traits<float>::log_polynomial[6] =
+      {
+         6.666666865e-01f, 4.000000060e-01f, 2.857142985e-01f,
+         2.222222239e-01f, 1.818181872e-01f, 1.538461596e-01f
+      };
+
+      // (-1)^k / (2k + 1)! for k = 1 .. 4.
+      const double vector_math_traits<float>::sin_polynomial[4] =
+      {
+         -0.16666666666666666, 0.008333333333333333, -0.0001984126984126984,
+          2.7557319223985893e-06
+      };
+
+      // (-1)^k / (2k)! for k = 2 .. 5.
+      const double vector_math_traits<float>::cos_polynomial[4] =
+      {
+          0.041666666666666664, -0.001388888888888889, 2.48015873015873e-05,
+         -2.755731922398589e-07
+      };
+
+      template <>
+      struct vector_math_traits<double>
+      {
+         typedef uint64_t unsigned_t;
+         typedef int64_t  signed_t;
+
+         static const bool        enabled       = true;
+         static const std::size_t mantissa_bits = 52;
+         static const unsigned_t  bias          = 1023;
+         static const unsigned_t  sqrt_half     = 0x3FE6A09E667F3BCDull;
+
+         static const double shifter;
+         static const double log2e;
+         static const double ln2_hi;
+         static const double ln2_lo;
+         static const double exp_min;
+         static const double exp_max;
+         static const double min_normal;
+         static const double subnormal_scale;
+         static const double subnormal_exponent;
+         static const double two_over_pi;
+         static const double trig_limit;
+
+         // pi / 2 as four parts, the first three of 33 bits, so that their
+         // products with quadrants below 2^20 are exact.
+         static const double pio2[4];
+
+         static const double exp_polynomial[12];
+         static const double log_polynomial[11];
+         static const double sin_polynomial[9];
+         static const double cos_polynomial[8];
+      };
+
+      const double vector_math_traits<double>::shifter            = 6755399441055744.0;
+      const double vector_math_traits<double>::log2e              = 1.44269504088896338700e+00;
+      const double vector_math_traits<double>::ln2_hi             = 6.93147180369123816490e-01;
+      const double vector_math_traits<double>::ln2_lo             = 1.90821492927058770002e-10;
+      const double vector_math_traits<double>::exp_min            = -746.0;
+      const double vector_math_traits<double>::exp_max            = 710.0;
+      const double vector_math_traits<double>::min_normal         = 2.2250738585072014e-308;
+      const double vector_math_traits<double>::subnormal_scale    = 18014398509481984.0;
+      const double vector_math_traits<double>::subnormal_exponent = -54.0;
+      const double vector_math_traits<double>::two_over_pi        = 6.36619772367581382433e-01;
+      const double vector_math_traits<double>::trig_limit         = 1048576.0;
+
+      const double vector_math_traits<double>::pio2[4] =
+      {
+         1.57079632673412561417e+00, 6.07710050630396597660e-11,
+         2.02226624871116645580e-21, 8.47842766036889956997e-32
+      };
+
+      // 1 / k! for k = 2 .. 13.
+      const double vector_math_traits<double>::exp_polynomial[12] =
+      {
+         0.5                 , 0.16666666666666666 , 0.041666666666666664,
+         0.008333333333333333, 0.001388888888888889, 0.0001984126984126984,
+         2.48015873015873e-05, 2.7557319223985893e-06, 2.755731922398589e-07,
+         2.505210838544172e-08, 2.08767569878681e-09, 1.6059043836821613e-10
+      };
+
+      // 2 / (2k + 1) for k = 1 .. 11.
+      const double vector_math_traits<double>::log_polynomial[11] =
+      {
+         0.6666666666666666 , 0.4                , 0.2857142857142857 ,
+         0.2222222222222222 , 0.18181818181818182, 0.15384615384615385,
+         0.13333333333333333, 0.11764705882352941, 0.10526315789473684,
+         0.09523809523809523, 0.08695652173913043
+      };
+
+      // (-1)^k / (2k + 1)! for k = 1 .. 9.
+      const double vector_math_traits<double>::sin_polynomial[9] =
+      {
+         -0.16666666666666666 , 0.008333333333333333 , -0.0001984126984126984,
+          2.7557319223985893e-06, -2.505210838544172e-08, 1.6059043836821613e-10,
+         -7.647163731819816e-13 , 2.8114572543455206e-15, -8.22063524662433e-18
+      };
+
+      // (-1)^k / (2k)! for k = 2 .. 9.
+      const double vector_math_traits<double>::cos_polynomial[8] =
+      {
+          0.041666666666666664, -0.001388888888888889 , 2.48015873015873e-05,
+         -2.755731922398589e-07, 2.08767569878681e-09 , -1.1470745597729725e-11,
+          4.779477332387385e-14, -1.5619206968586225e-16
+      };
+
+      template <typename S, std::size_t Bytes>
+      struct simd_math;
+
+      // sin and cos of double vectors, from x - n pi/2 = r + c held in
+      // double-double arithmetic, |r| <= pi/4, with the polynomials of
+      // Polynomials.
+      template <typename S, std::size_t Bytes>
+      struct simd_trig
+      {
+         typedef simd_math<S,Bytes>     math_t;
+         typedef typename math_t::V     V;
+         typedef typename math_t::U     U;
+         typedef typename math_t::I     I;
+         typedef vector_math_traits<S>  traits_t;
+
+         template <bool Cosine, typename Polynomials = traits_t>
+         static exprtk_simd_inline V process(const V& x)
+         {
+            const V t = x * traits_t::two_over_pi + traits_t::shifter;
+            const V n = t - traits_t::shifter;
+            const V a = x - n * traits_t::pio2[0];
+            const V b = -(n * traits_t::pio2[1]);
+            const V s = a + b;
+            const V e = math_t::sum_error(a, b, s) - n * traits_t::pio2[2] - n * traits_t::pio2[3];
+            const V r = s + e;
+            const V c = math_t::sum_error(s, e, r);
+
+            const V z = r * r;
+            const V h = S(0.5) * z;
+            const V w = S(1) - h;
+
+            const V sine   = r + ((r * z) * math_t::polynomial(z, Polynomials::sin_polynomial) + c);
+            const V cosine = w + ((((S(1) - w) - h) + (z * z) * math_t::polynomial(z, Polynomials::cos_polynomial)) - r * c);
+
+            // Quadrants 1 and 3 take the cosine of r, 2 and 3 negate.
+            const U q   = (reinterpret_cast<U>(t) - reinterpret_cast<U>(math_t::splat(traits_t::shifter))) + (Cosine ? 1 : 0);
+            const U odd = -(q & 1);
+
+            V y = reinterpret_cast<V>(((reinterpret_cast<U>(cosine) & odd) | (reinterpret_cast<U>(sine) & ~odd)) ^
+                                      ((q & 2) << (math_t::bits - 2)));
+
+            const I large = (math_t::abs(x) > traits_t::trig_limit);
+
+            if (math_t::any(large))
+            {
+               for (std::size_t i = 0; i < math_t::lanes; ++i)
+               {
+                  if (large[i])
+                     y[i] = Cosine ? std::cos(x[i]) : std::sin(x[i]);
+               }
+            }
+
+            return y;
+         }
+      };
+
+      // Float arguments are widened, the reduction needing more precision
+      // than a float holds near multiples of pi/2, one half of the vector
+      // at a time. Shorter polynomials do for the float result.
+      template <std::size_t Bytes>
+      struct simd_trig<float,Bytes>
+      {
+         typedef typename simd_math<float,Bytes>::V V;
+         typedef typename simd_math<double,Bytes>::V W;
+         typedef float H __attribute__((vector_size(Bytes / 2)));
+
+         template <bool Cosine>
+         static exprtk_simd_inline V process(const V& x)
+         {
+            H half[2];
+            std::memcpy(half, &x, sizeof(V));
+
+            for (std::size_t i = 0; i < 2; ++i)
+            {
+               half[i] = __builtin_convertvector(simd_trig<double,Bytes>::template process<Cosine,vector_math_traits<float> >(__builtin_convertvector(half[i], W)), H);
+            }
+
+            V y;
+            std::memcpy(&y, half, sizeof(V));
+
+            return y;
+         }
+      };
+
+      template <typename S, std::size_t Bytes>
+      struct simd_math
+      {
+         typedef vector_math_traits<S>         traits_t;
+         typedef typename traits_t::unsigned_t unsigned_t;
+         typedef typename traits_t::signed_t   signed_t;
+
+         typedef S          V __attribute__((vector_size(Bytes)));
+         typedef unsigned_t U __attribute__((vector_size(Bytes)));
+         typedef signed_t   I __attribute__((vector_size(Bytes)));
+
+         static const std::size_t lanes = Bytes / sizeof(S);
+         static const std::size_t bits  = 8 * sizeof(S);
+
+         static const unsigned_t sign_mask     = unsigned_t(1) << (bits - 1);
+         static const unsigned_t mantissa_mask = (unsigned_t(1) << traits_t::mantissa_bits) - 1;
+
+         static exprtk_simd_inline V load(const S* p)
+         {
+            V v;
+            std::memcpy(&v, p, sizeof(V));
+            return v;
+         }
+
+         static exprtk_simd_inline void store(S* p, const V& v)
+         {
+            std::memcpy(p, &v, sizeof(V));
+         }
+
+         static exprtk_simd_inline V splat(const S s)
+         {
+            V v;
+
+            for (std::size_t i = 0; i < lanes; ++i)
+            {
+               v[i] = s;
+            }
+
+            return v;
+         }
+
+         static exprtk_simd_inline bool any(const I& mask)
+         {
+            signed_t result = 0;
+
+            for (std::size_t i = 0; i < lanes; ++i)
+            {
+               result |= mask[i];
+            }
+
+            return (0 != result);
+         }
+
+         static exprtk_simd_inline V abs(const V& x)
+         {
+            return reinterpret_cast<V>(reinterpret_cast<U>(x) & ~sign_mask);
+         }
+
+         // Lanes of a where mask is set, of b elsewhere. Bitwise, as the
+         // conditional operator does not map onto every instruction set.
+         static exprtk_simd_inline V select(const I& mask, const V& a, const V& b)
+         {
+            const U m = reinterpret_cast<U>(mask);
+
+            return reinterpret_cast<V>((reinterpret_cast<U>(a) & m) | (reinterpret_cast<U>(b) & ~m));
+         }
+
+         // The rounding error of s = a + b, exactly.
+         static exprtk_simd_inline V sum_error(const V& a, const V& b, const V& s)
+         {
+            const V v = s - a;
+
+            return (a - (s - v)) + (b - v);
+         }
+
+         // The nearest integer, ties to even, for |x| < 2^(mantissa_bits - 1).
+         static exprtk_simd_inline V round(const V& x)
+         {
+            return (x + traits_t::shifter) - traits_t::shifter;
+         }
+
+         // 2^n for integral n within the normal exponent range.
+         static exprtk_simd_inline V pow2(const V& n)
+         {
+            const U k = reinterpret_cast<U>(n + traits_t::shifter) - reinterpret_cast<U>(splat(traits_t::shifter));
+
+            return reinterpret_cast<V>((k + traits_t::bias) << traits_t::mantissa_bits);
+         }
+
+         template <std::size_t N>
+         static exprtk_simd_inline V polynomial(const V& x, const S (&c)[N])
+         {
+            V result = splat(c[N - 1]);
+
+            for (std::size_t i = N - 1; i > 0; --i)
+            {
+               result = result * x + c[i - 1];
+            }
+
+            return result;
+         }
+
+         static exprtk_simd_inline V clamp(const V& x, const S lower, const S upper)
+         {
+            return select(x < lower, splat(lower), select(x > upper, splat(upper), x));
+         }
+
+         // e^x = 2^n e^r, where n is the integer nearest x / ln2, taken
+         // as 2^(n/2) 2^(n - n/2) so both factors stay normal.
+         static exprtk_simd_inline V exp(const V& x)
+         {
+            const V c = clamp(x, traits_t::exp_min, traits_t::exp_max);
+            const V n = round(c * traits_t::log2e);
+            const V r = (c - n * traits_t::ln2_hi) - n * traits_t::ln2_lo;
+            const V h = round(n * S(0.5));
+
+            const V p = S(1) + (r + (r * r) * polynomial(r, traits_t::exp_polynomial));
+
+            return (p * pow2(h)) * pow2(n - h);
+         }
+
+         // 2^n (e^r - 1) + (2^n - 1), or 2^n e^r - 1 once 2^n makes the
+         // difference negligible.
+         static exprtk_simd_inline V expm1(const V& x)
+         {
+            const V c = clamp(x, traits_t::exp_min, traits_t::exp_max);
+            const V n = round(c * traits_t::log2e);
+            const V r = (c - n * traits_t::ln2_hi) - n * traits_t::ln2_lo;
+            const V h = round(n * S(0.5));
+
+            const V q  = r + (r * r) * polynomial(r, traits_t::exp_polynomial);
+            const V s0 = pow2(h);
+            const V s1 = pow2(n - h);
+
+            const V near = (q * s0) * s1 + ((s0 * s1) - S(1));
+            const V far  = ((q + S(1)) * s0) * s1 - S(1);
+
+            return select(x == S(0), x, select(n > S(traits_t::mantissa_bits + 2), far, near));
+         }
+
+         // log(m 2^k) = k ln2 + log(m), m in [sqrt(1/2), sqrt(2)), with
+         // log(m) = 2 atanh(s) and s = (m - 1) / (m + 1).
+         static exprtk_simd_inline V log(const V& x)
+         {
+            const I subnormal = (x < traits_t::min_normal);
+
+            const V xs = select(subnormal, x * traits_t::subnormal_scale, x);
+            const V e  = select(subnormal, splat(traits_t::subnormal_exponent), splat(S(0)));
+            const U ix = reinterpret_cast<U>(xs) + ((traits_t::bias << traits_t::mantissa_bits) - traits_t::sqrt_half);
+            const U ks = reinterpret_cast<U>(splat(traits_t::shifter));
+
+            const V k    = (reinterpret_cast<V>(((ix >> traits_t::mantissa_bits) - traits_t::bias) + ks) - traits_t::shifter) + e;
+            const V m    = reinterpret_cast<V>((ix & mantissa_mask) + traits_t::sqrt_half);
+            const V f    = m - S(1);
+            const V s    = f / (f + S(2));
+            const V z    = s * s;
+            const V hfsq = (S(0.5) * f) * f;
+            const V R    = z * polynomial(z, traits_t::log_polynomial);
+
+            const V y = k * traits_t::ln2_hi + (f - (hfsq - (s * (hfsq + R) + k * traits_t::ln2_lo)));
+
+            // Positive and finite, as a single unsigned comparison.
+            const I normal = ((reinterpret_cast<U>(x) - 1) <
+                              (reinterpret_cast<U>(splat(std::numeric_limits<S>::infinity())) - 1));
+
+            const V special = select(x == S(0), splat(-std::numeric_limits<S>::infinity()),
+                              select(x <  S(0), splat( std::numeric_limits<S>::quiet_NaN()), x));
+
+            return select(normal, y, special);
+         }
+
+         // (1 - e^-2|x|) / (1 + e^-2|x|) with the sign of x.
+         static exprtk_simd_inline V tanh(const V& x)
+         {
+            const V u = expm1(abs(x) * S(-2));
+            const V t = -u / (u + S(2));
+
+            return reinterpret_cast<V>((reinterpret_cast<U>(t) & ~sign_mask) | (reinterpret_cast<U>(x) & sign_mask));
+         }
+
+         static exprtk_simd_inline V sin(const V& x)
+         {
+            return simd_trig<S,Bytes>::template process<false>(x);
+         }
+
+         static exprtk_simd_inline V cos(const V& x)
+         {
+            return simd_trig<S,Bytes>::template process<true>(x);
+         }
+
+         // The last, partial vector is computed padded, giving every
+         // element the same result wherever it lies.
+         template <typename Function>
+         static exprtk_simd_inline void unary(const S* v0, S* result, const std::size_t size)
+         {
+            std::size_t i = 0;
+
+            for ( ; (i + lanes) <= size; i += lanes)
+            {
+               store(result + i, Function::template process<simd_math>(load(v0 + i)));
+            }
+
+            if (i < size)
+            {
+               S buffer[lanes];
+
+               std::fill_n(buffer, lanes, S(0));
+               std::copy(v0 + i, v0 + size, buffer);
+               store(buffer, Function::template process<simd_math>(load(buffer)));
+               std::copy(buffer, buffer + (size - i), result + i);
+            }
+         }
+      };
+
+      #define exprtk_define_vector_math_op(Function)                                 \
+      struct vector_##Function##_op                                                  \
+      {                                                                              \
+         template <typename M>                                                       \
+         static exprtk_simd_inline typename M::V process(const typename M::V& x)     \
+         {                                                                           \
+            return M::Function(x);                                                   \
+         }                                                                           \
+      };                                                                             \
+
+      exprtk_define_vector_math_op(exp  )
+      exprtk_define_vector_math_op(expm1)
+      exprtk_define_vector_math_op(log  )
+      exprtk_define_vector_math_op(sin  )
+      exprtk_define_vector_math_op(cos  )
+      exprtk_define_vector_math_op(tanh )
+
+      #undef exprtk_define_vector_math_op
+
+      #define exprtk_define_vector_math_isa(Isa, Target, Bytes)                 \
+      template <typename S>                                                     \
+      struct vector_math_##Isa                                                  \
+      {                                                                         \
+         template <typename Op>                                                 \
+         __attribute__((target(Target)))                                        \
+         static void unary(const S* v0, S* result, const std::size_t size)      \
+         {                                                                      \
+            simd_math<S,Bytes>::template unary<Op>(v0, result, size);           \
+         }                                                                      \
+      };                                                                        \
+
+      exprtk_define_vector_math_isa(sse2  , "sse2"   , 16)
+      exprtk_define_vector_math_isa(avx2  , "avx2"   , 32)
+      exprtk_define_vector_math_isa(avx512, "avx512f", 64)
+
+      #undef exprtk_define_vector_math_isa
+
+      template <typename T, template <typename> class Isa>
+      struct vector_math_table_builder
+      {
+         typedef vector_math_table<T> table_t;
+         typedef Isa<T>               isa_t;
+
+         static void fill(table_t& table, const char* isa)
+         {
+            table.exp   = &isa_t::template unary<vector_exp_op  >;
+            table.expm1 = &isa_t::template unary<vector_expm1_op>;
+            table.log   = &isa_t::template unary<vector_log_op  >;
+            table.sin   = &isa_t::template unary<vector_sin_op  >;
+            table.cos   = &isa_t::template unary<vector_cos_op  >;
+            table.tanh  = &isa_t::template unary<vector_tanh_op >;
+            table.isa   = isa;
+         }
+      };
+
+      template <typename T, bool Enabled = vector_math_traits<T>::enabled>
+      struct vector_math_selector
+      {
+         static void select(vector_math_table<T>&)
+         {}
+      };
+
+      template <typename T>
+      struct vector_math_selector<T,true>
+      {
+         static void select(vector_math_table<T>& table)
+         {
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx512f"))
+               vector_math_table_builder<T,vector_math_avx512>::fill(table, "avx512f");
+            else if (__builtin_cpu_supports("avx2"))
+               vector_math_table_builder<T,vector_math_avx2  >::fill(table, "avx2"   );
+            else if (__builtin_cpu_supports("sse2"))
+               vector_math_table_builder<T,vector_math_sse2  >::fill(table, "sse2"   );
+         }
+      };
+      #endif
+
+      template<typename T> vector_math_table<T> vector_math_table<T>::select()
+      {
+         vector_math_table<T> table;
+
+         #ifdef exprtk_enable_vector_math
+         vector_math_selector<T>::select(table);
+         #endif
+
+         return table;
+      }
+
+      template<typename T> const vector_math_table<T>& vector_math_table<T>::instance()
+      {
+         static const vector_math_table<T> table = select();
+
+         return table;
+      }
+
+      template<typename T> typename vector_math<T>::unary_t vector_math<T>::unary(const operator_type operation)
+      {
+         const vector_math_table<T>& table = vector_math_table<T>::instance();
+
+         switch (operation)
+         {
+            case e_exp   : return table.exp;
+            case e_expm1 : return table.expm1;
+            case e_log   : return table.log;
+            case e_sin   : return table.sin;
+            case e_cos   : return table.cos;
+            case e_tanh  : return table.tanh;
+            default      : return 0;
+         }
+      }
+
+      template<typename T> typename vector_math<T>::unary_t vector_math<T>::unary(ufunc_t function)
+      {
+         #define vector_math_case(op)                                      \
+         if (static_cast<ufunc_t>(&op##_op<T>::process) == function)       \
+            return unary(e_##op);                                          \
+
+         vector_math_case(exp  ) vector_math_case(expm1)
+         vector_math_case(log  ) vector_math_case(sin  )
+         vector_math_case(cos  ) vector_math_case(tanh )
+         #undef vector_math_case
+
+         return 0;
+      }
+
+      template<typename T> const char* vector_math<T>::isa()
+      {
+         return vector_math_table<T>::instance().isa;
+      }
+
+      template struct vector_math<int16_t>;
+      template struct vector_math<int32_t>;
+      template struct vector_math<int64_t>;
+      template struct vector_math<float>;
+      template struct vector_math<double>;
+      template struct vector_math<long double>;
+      template struct vector_math<std::complex<float>>;
+      template struct vector_math<std::complex<double>>;
+      template struct vector_math<std::complex<long double>>;
+   }
+}